@@ -13,8 +13,13 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <math.h>
+#include <string.h>
 #include "threadpool.h"
 #include "colorpalette.h"
+#include "doubledouble.h"
+#include "fixedpoint.h"
+#include "perturbation.h"
+#include "buddhabrot.h"
 
 /**
  * @struct mandelData
@@ -22,6 +27,12 @@
  */
 typedef struct mandelData mandelData;
 
+/**
+ * @struct mandelRealtime
+ * @brief the @ref mandelRealtime struct renders frames of a @ref mandelData within a time budget, for interactive use. Created with mandel_createRealtime.
+ */
+typedef struct mandelRealtime mandelRealtime;
+
 /**
  * @struct renderThread
  * @brief the @ref renderThread struct is used to keep track of the thread holding the threadpool and the image rendered.
@@ -31,6 +42,77 @@ typedef struct renderThread {
     pthread_t thread;
 } renderThread;
 
+/**
+ * @enum mandelPrecision
+ * @brief The arithmetic used by the kernels when rendering.
+ */
+typedef enum mandelPrecision {
+    MANDEL_PRECISION_FLOAT, /**< single precision, for shallow zooms */
+    MANDEL_PRECISION_DOUBLE, /**< double precision */
+    MANDEL_PRECISION_DOUBLEDOUBLE, /**< double-double precision, for zooms beyond about 1e-13 when perturbation is turned off */
+    MANDEL_PRECISION_PERTURBATION, /**< double precision offsets from a reference orbit in double-double or fixed-point, for zooms beyond about 1e-13 */
+    MANDEL_PRECISION_FIXED /**< fixed-point, for zooms beyond about 1e-28 when perturbation is turned off */
+} mandelPrecision;
+
+//passed as the number of threads or the split of a render to use the ones tuned for the host and the size of the image by mandel_tune, or a thread per processor if they have not been tuned
+#define MANDEL_AUTO 0
+
+//the profile file of the tuned settings, in the working directory, unless another one is set with mandel_setProfile
+#define MANDEL_PROFILE_FILE "mandelpool.profile"
+
+//the highest power of z supported by mandel_setFormula
+#define MANDEL_MAX_POWER 4
+
+/**
+ * @enum mandelFormula
+ * @brief The fractal that is rendered.
+ */
+typedef enum mandelFormula {
+    MANDEL_FORMULA_MANDELBROT, /**< z' = z^d + c with z starting at 0 */
+    MANDEL_FORMULA_JULIA, /**< z' = z^d + seed with z starting at the point */
+    MANDEL_FORMULA_BURNING_SHIP /**< z' = (|x| + i|y|)^d + c with z starting at 0 */
+} mandelFormula;
+
+/**
+ * @enum mandelRenderMode
+ * @brief How the pixels of a visualization are colored.
+ */
+typedef enum mandelRenderMode {
+    MANDEL_RENDER_ESCAPE_TIME, /**< colored by the smooth iteration-count, and anti-aliased by supersampling the pixels that differ from their neighbors */
+    MANDEL_RENDER_DISTANCE, /**< colored by the smooth iteration-count and darkened by the distance-estimation close to the set, with one orbit per pixel and no supersampling */
+    MANDEL_RENDER_BUDDHABROT /**< colored by the density of the orbits of the points that escape (the buddhabrot), always of the mandelbrot-set with power 2 */
+} mandelRenderMode;
+
+/**
+ * @struct mandelStats
+ * @brief the @ref mandelStats struct contains counters collected during the last render of a @ref mandelData.
+ */
+typedef struct mandelStats {
+    long long iterations; /**< iterations actually calculated */
+    long long cardioidSaved; /**< iterations saved by the main cardioid and period-2 bulb test */
+    long long periodSaved; /**< iterations saved by periodicity detection */
+    long long derivativeSaved; /**< iterations saved by derivative-based interior detection */
+    long long references; /**< reference orbits calculated for perturbation, including the ones for glitched points */
+    long long seriesSkipped; /**< iterations skipped by the series approximation, not included in iterations */
+    long long filledPixels; /**< pixels filled by rectangle checking without being iterated */
+    long long antiAliasSamples; /**< extra samples taken by the anti-aliasing pass */
+    long long mirroredPixels; /**< pixels copied from their mirror image across the real axis instead of being calculated */
+    long long resumedPixels; /**< pixels continued from where the last render stopped, after the iteration cap was raised */
+    mandelPrecision precision; /**< the precision chosen from the pixel size of the view */
+    int fixedBits; /**< the width of the fixed-point numbers chosen from the pixel size of the view, 0 if double-double was enough */
+} mandelStats;
+
+/**
+ * @struct mandelRegionQuality
+ * @brief the @ref mandelRegionQuality struct is the quality a part of the image reached in a render with a time budget.
+ */
+typedef struct mandelRegionQuality {
+    int x, y, w, h; /**< the part of the image, in pixels */
+    int step; /**< the pixels of the part were calculated in blocks of step*step pixels, 1 is full resolution, 0 if the deadline came before all of them were calculated once and the part still holds some of the image before the render */
+    int samples; /**< the largest number of samples taken in a pixel of the part, 1 if it was not anti-aliased */
+    int iterations; /**< the iteration cap the part was calculated with */
+} mandelRegionQuality;
+
 /**
  * @brief Creates a mandelData struct.
  * @param iterations Maximum number of iterations when deciding if a coordinate is in the mandelbrot set.
@@ -48,21 +130,224 @@ struct mandelData * mandel_createMandelData(int iterations, double xFrom, double
 /**
  * @brief Renders a visualization of the mandelbrot-set.
  * @param m The settings of the visualization.
- * @param numthreads The number of threads to use for rendering the set.
- * @param split The number of splits to be done. Number of squares = split^2.
- * @return An image with the dimesions given in the settings. Basically a 3d-array with dimensions width*height*3, where 3 is the rgb componenets of each pixel.
+ * @param numthreads The number of threads to use for rendering the set, or MANDEL_AUTO for the number in the profile, which also sets how small the tiles split themselves.
+ * @param split The square root of the number of jobs the anti-aliasing pass is split into, or MANDEL_AUTO for the one in the profile. The image itself is always calculated in small tiles pulled by the threads one at a time.
+ * @return An image with the dimesions given in the settings. Basically a 3d-array with dimensions width*height*3, where 3 is the rgb componenets of each pixel. In blocks instead of rows when the tiled layout is on, see mandel_setTiledLayout.
  */
 unsigned int * mandel_render(struct mandelData * m, int numthreads, int split);
 
+/**
+ * @brief Renders a visualization of the mandelbrot-set within a time budget. The image is calculated in passes over all of it, from blocks of 16*16 pixels down to single pixels, and every pass stops at the deadline, leaving the image of the passes done so far. Before the first pass the cost of the view is probed in a small fraction of the budget: the iteration cap is lowered for this render, down to an eighth of it, if full resolution would not be reached in time otherwise, and once full resolution is reached the pixels are anti-aliased with as many samples as the time left allows. Choosing the automatic iteration cap and calculating the reference orbit are not stopped by the deadline. The buddhabrot render mode is rendered as by mandel_render, without a budget.
+ * @param m The settings of the visualization.
+ * @param numthreads The number of threads to use for rendering the set, or MANDEL_AUTO.
+ * @param split The square root of the number of jobs the anti-aliasing pass is split into, or MANDEL_AUTO.
+ * @param budget The time the render may take, in seconds.
+ * @return The image, the quality each part of it reached is given by mandel_getQuality.
+ */
+unsigned int * mandel_renderBudget(struct mandelData * m, int numthreads, int split, double budget);
+
+/**
+ * @brief Gets the quality the parts of the image reached in the last render, if it was rendered by mandel_renderBudget.
+ * @param m The settings of the visualization.
+ * @param count Set to the number of parts, 0 if the last render had no budget.
+ * @return The parts, which together cover the image. They are kept until the next render.
+ */
+const mandelRegionQuality * mandel_getQuality(struct mandelData * m, int * count);
+
 /**
  * @brief Renders a visualization of the mandelbrot-set but instantly returns the image, even if it is not finished.
  * @param m The settings of the visualization.
- * @param numthreads The number of threads to use for rendering the set.
- * @param split The number of sprits to be done. Number of squares = split^2.
+ * @param numthreads The number of threads to use for rendering the set, or MANDEL_AUTO.
+ * @param split The square root of the number of jobs the anti-aliasing pass is split into, or MANDEL_AUTO.
  * @return A pointer to a struct cointaining the rendered image and the thread running the threadpool. The image may not be finished and the thread must be joined to free resources.
  */
 renderThread * mandel_renderUnfinished(struct mandelData * m, int numthreads, int split);
 
+/**
+ * @brief Creates a realtime renderer for a visualization. Its threads and buffers are created once and kept until mandel_destroyRealtime, so that rendering a frame allocates nothing.
+ * @param m The settings of the visualization, used by every frame. They may be changed between frames.
+ * @param numthreads The number of threads, or MANDEL_AUTO for the number in the profile.
+ * @return A mandelRealtime struct.
+ */
+mandelRealtime * mandel_createRealtime(mandelData * m, int numthreads);
+
+/**
+ * @brief Renders a frame. The image is refined in passes, from blocks of 8*8 pixels down to single pixels, and the frame stops where it is when the budget runs out. The next frame continues from there, or starts over from the coarsest pass if the view, the iteration cap, the formula, the julia seed, the render mode, the interior detection or a color of the palette has changed. Only the precisions up to double are used, deeper views are rendered in double precision.
+ * @param r The realtime renderer.
+ * @param budget The time the frame may take, in seconds.
+ * @return The image, which stays at the same address for every frame.
+ */
+unsigned int * mandel_renderFrame(mandelRealtime * r, double budget);
+
+/**
+ * @brief Checks if the frames have reached full resolution, so that rendering more frames would not change the image until the settings do.
+ * @param r The realtime renderer.
+ * @return true if the image is complete.
+ */
+bool mandel_isFrameComplete(mandelRealtime * r);
+
+/**
+ * @brief Stops the threads of a realtime renderer and frees it. The visualization is not destroyed.
+ * @param r The realtime renderer.
+ */
+void mandel_destroyRealtime(mandelRealtime * r);
+
+/**
+ * @brief Moves the visualization to other bounds in the complex-plane, keeping its image size and settings. A visualization that is moved rather than created again keeps its threads, and gives every part of the image to the thread that calculated it the last time.
+ * @param m The settings of the visualization.
+ * @param xFrom Left bound in the complex-plane that is to be rendered.
+ * @param yFrom Upper bound in the complex-plane that is to be rendered.
+ * @param xTo Right bound in the complex-plane that is to be rendered.
+ * @param yTo Bottom bound in the complex-plane that is to be rendered.
+ */
+void mandel_setLocation(mandelData * m, double xFrom, double yFrom, double xTo, double yTo);
+
+/**
+ * @brief Moves the visualization so that it is centered at the given point, keeping its size. Use this instead of the bounds given to mandel_createMandelData when the center needs more precision than a double.
+ * @param m The settings of the visualization.
+ * @param x x-position of the new center in the complex-plane.
+ * @param y y-position of the new center in the complex-plane.
+ */
+void mandel_setCenter(mandelData * m, doubleDouble x, doubleDouble y);
+
+/**
+ * @brief Moves the visualization like mandel_setCenter, with the center given as decimal strings such as "-1.768573656315270993281742915329544712934120053", which can not be represented by a double.
+ * @param m The settings of the visualization.
+ * @param x x-position of the new center as a decimal string.
+ * @param y y-position of the new center as a decimal string.
+ */
+void mandel_setCenterString(mandelData * m, const char * x, const char * y);
+
+/**
+ * @brief Sets the maximum number of iterations. When the cap is raised and no other setting has been set since the last render, the next render continues the pixels that reached the old cap from where they stopped, and keeps the pixels that escaped as they are. This is done for the single and double precision kernels, deeper views are rendered from the start.
+ * @param m The settings of the visualization.
+ * @param iterations Maximum number of iterations when deciding if a coordinate is in the mandelbrot set.
+ */
+void mandel_setIterations(mandelData * m, int iterations);
+
+/**
+ * @brief Gets the maximum number of iterations, which is chosen by mandel_render when the automatic iteration cap is on.
+ * @param m The settings of the visualization.
+ * @return Maximum number of iterations when deciding if a coordinate is in the mandelbrot set.
+ */
+int mandel_getIterations(mandelData * m);
+
+/**
+ * @brief Turns the automatic iteration cap on or off. When it is on, every render first iterates a coarse probe of the view, and uses the smallest cap that leaves only a small fraction of the probe escaping after it. It is off by default.
+ * @param m The settings of the visualization.
+ * @param enabled If the iteration cap should be chosen automatically.
+ */
+void mandel_setAutoIterations(mandelData * m, bool enabled);
+
+/**
+ * @brief Turns detection of interior points by the derivative of the orbit on or off. It is off by default.
+ * @param m The settings of the visualization.
+ * @param enabled If interior detection should be used.
+ */
+void mandel_setInteriorDetection(mandelData * m, bool enabled);
+
+/**
+ * @brief Turns perturbation on or off for zooms beyond double precision. It is on by default, when it is off every point is iterated in double-double precision instead.
+ * @param m The settings of the visualization.
+ * @param enabled If perturbation should be used.
+ */
+void mandel_setPerturbation(mandelData * m, bool enabled);
+
+/**
+ * @brief Turns the series approximation on or off. When it is on, points iterated with perturbation skip the iterations where their offsets from the reference can be approximated by a series within a small fraction of a pixel. It is on by default.
+ * @param m The settings of the visualization.
+ * @param enabled If the series approximation should be used.
+ */
+void mandel_setSeriesApproximation(mandelData * m, bool enabled);
+
+/**
+ * @brief Turns rectangle checking on or off. When it is on, the tiles are rendered by iterating the borders of rectangles, filling the rectangles whose borders all have the same iteration-count and splitting the others. The smooth coloring of a filled rectangle is interpolated from its corners, so the colors are an approximation of a full render. A render with rectangle checking is started over when the iteration cap is raised, instead of being resumed. It is off by default, since the cardioid and periodicity checks already make most interiors cheap.
+ * @param m The settings of the visualization.
+ * @param enabled If rectangle checking should be used.
+ */
+void mandel_setRectangleChecking(mandelData * m, bool enabled);
+
+/**
+ * @brief Sets the largest number of samples taken in a pixel. After one sample per pixel has been rendered, the pixels that differ strongly from a neighbor are supersampled in rounds of 8 samples, until a round no longer changes their color or this number is reached. It is 9 by default, the same number of samples as the fixed 3x3 supersampling it replaced.
+ * @param m The settings of the visualization.
+ * @param maxSamples The largest number of samples per pixel, 1 turns anti-aliasing off.
+ */
+void mandel_setAntiAliasing(mandelData * m, int maxSamples);
+
+/**
+ * @brief Sets the fractal that is rendered. Each formula and power has its own kernel, instantiated at compile time. All but the mandelbrot-set with power 2 are rendered in double precision, without perturbation, the distance-estimation or resuming. It is the mandelbrot-set with power 2 by default.
+ * @param m The settings of the visualization.
+ * @param formula The formula.
+ * @param power The power of z, from 2 to MANDEL_MAX_POWER.
+ */
+void mandel_setFormula(mandelData * m, mandelFormula formula, int power);
+
+/**
+ * @brief Sets the seed added in every iteration of a julia-set. It is 0 by default.
+ * @param m The settings of the visualization.
+ * @param x x-position of the seed.
+ * @param y y-position of the seed.
+ */
+void mandel_setJuliaSeed(mandelData * m, double x, double y);
+
+/**
+ * @brief Sets how the pixels are colored. The distance mode draws the boundary and thin filaments from the distance-estimation of a single orbit per pixel, which makes it a cheap mode for thumbnails. It is MANDEL_RENDER_ESCAPE_TIME by default.
+ * @param m The settings of the visualization.
+ * @param mode The render mode.
+ */
+void mandel_setRenderMode(mandelData * m, mandelRenderMode mode);
+
+/**
+ * @brief Sets the number of orbits sampled per pixel in the buddhabrot render mode. The orbits are split evenly between one sampling chain per thread. Every running chain has a histogram as large as the image, so for large images fewer chains run at a time, keeping the histograms within 1 GB. It is 4 by default.
+ * @param m The settings of the visualization.
+ * @param samples The number of orbits per pixel.
+ */
+void mandel_setBuddhabrotSamples(mandelData * m, int samples);
+
+/**
+ * @brief Turns the tiled layout of the image on or off. When it is on, the image returned by the renders is stored in blocks of 64*64 pixels, each block row by row and the blocks one after another in the order of the image, the blocks at the right and bottom edges padded to full size. The threads then write and anti-alias pixels that lie together in memory instead of a row of the whole image apart, and the image is converted to rows by mandel_exportImage. The image is reallocated and cleared when the layout changes, so it must not be changed while a render or a realtime renderer uses the settings. It is off by default.
+ * @param m The settings of the visualization.
+ * @param enabled If the image should be stored in blocks.
+ */
+void mandel_setTiledLayout(mandelData * m, bool enabled);
+
+/**
+ * @brief Turns the pinning of the render threads on or off. When it is on, every thread is pinned to the cpus of one NUMA node, so that it stays on the node that holds the rows it wrote first; see threadpool_pinThreads. It only helps on machines with more than one node, and keeps the threads from moving to idle cpus of other nodes, so it is off by default. The threads are created again by the next render when it changes, so it must not be changed while a render or a realtime renderer uses the settings.
+ * @param m The settings of the visualization.
+ * @param enabled If the threads should be pinned.
+ */
+void mandel_setThreadPinning(mandelData * m, bool enabled);
+
+/**
+ * @brief Copies the image of the last render row by row, as it is stored without the tiled layout.
+ * @param m The settings of the visualization.
+ * @param out The image, width*height pixels.
+ */
+void mandel_exportImage(mandelData * m, unsigned int * out);
+
+/**
+ * @brief Calibrates the settings of the renders for this host and images of about the given size, and stores them in a profile file. A few scenes are rendered with different numbers of threads, sizes of the jobs and splits of the anti-aliasing pass, which takes some seconds. The images are sorted into classes by their number of pixels, from one square of side a power of 2 to the next, and the scenes are rendered at the size of the class, up to 8192*8192 pixels, with iteration caps lowered for the large classes. A render with MANDEL_AUTO never calibrates by itself, it uses a thread per processor and the default settings for a class the profile has no settings for. The file is replaced in one step, so renders reading it meanwhile see either the old or the new settings.
+ * @param path The profile file, NULL for MANDEL_PROFILE_FILE. The settings of other hosts and classes in it are kept.
+ * @param width The width of the images.
+ * @param height The height of the images.
+ * @return true if the profile file could be written.
+ */
+bool mandel_tune(const char * path, int width, int height);
+
+/**
+ * @brief Sets the profile file the renders with MANDEL_AUTO take their settings from. It is MANDEL_PROFILE_FILE by default.
+ * @param m The settings of the visualization.
+ * @param path The profile file, NULL for MANDEL_PROFILE_FILE.
+ */
+void mandel_setProfile(mandelData * m, const char * path);
+
+/**
+ * @brief Gets the statistics of the last render. Can be called while a render is running.
+ * @param m The settings of the visualization.
+ * @return The counters collected so far.
+ */
+mandelStats mandel_getStats(mandelData * m);
+
 /**
  * @brief Destroys and deallocates a mandelData struct
  * @param m A mandelData struct.
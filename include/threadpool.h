@@ -27,9 +27,8 @@ struct threadpool;
 struct threadpool * threadpool_create(int numThreads);
 
 /**
- * @brief Destroys the designated threadpool.
+ * @brief Destroys the designated threadpool. Waits with threadpool_wait until every job is done first.
  * @param pool The pool to destroy.
- * //param force If false the threadpool waits until the job queue is empty (while accepting no new jobs).
  */
 void threadpool_destroy(struct threadpool * pool);
 
@@ -42,5 +41,33 @@ void threadpool_destroy(struct threadpool * pool);
  */
 void threadpool_enqueue(struct threadpool * pool, void (*routine)(void*), void * arg);
 
+/**
+ * @brief Adds a job to the designated threadpool, to be run by one of its threads if possible. A thread runs the jobs given to it before any other job, and takes the jobs of the other threads only when there is nothing else left, so the job still runs if its thread is busy.
+ * @param pool Threadpool to add job to.
+ * @param routine Function to be run. Must be a function which takes one argument.
+ * @param arg The argument to routine.
+ * @param thread The index of the thread, from 0 to the number of threads - 1. Any other value gives the job to any thread, like threadpool_enqueue.
+ */
+void threadpool_enqueueTo(struct threadpool * pool, void (*routine)(void*), void * arg, int thread);
+
+/**
+ * @brief Gets the index of the calling thread in the designated threadpool, which jobs can use to send related jobs to the same thread later.
+ * @param pool The threadpool.
+ * @return The index, or -1 if the calling thread is not one of the threads of the pool.
+ */
+int threadpool_currentThread(struct threadpool * pool);
+
+/**
+ * @brief Pins every thread of the designated threadpool to the cpus of one NUMA node, the threads spread evenly over the cpus the process may run on. Memory a thread writes first is then placed on its node, and stays close to the thread for as long as the pool lives, while the scheduler still balances the threads over the cpus of the node. Does nothing on a machine with one node, or where cpu affinity or the nodes in /sys are not available.
+ * @param pool The threadpool.
+ */
+void threadpool_pinThreads(struct threadpool * pool);
+
+/**
+ * @brief Waits until every job added to the designated threadpool is done, including the jobs added by other jobs while they run. The pool can be given more jobs afterwards.
+ * @param pool The threadpool to wait for.
+ */
+void threadpool_wait(struct threadpool * pool);
+
 
 #endif // THREADPOOL__H
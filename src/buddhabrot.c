@@ -0,0 +1,257 @@
+/**
+ * @file buddhabrot.c
+ * @date 18/10 2026
+ * @brief Orbit-density rendering of the mandelbrot-set. Uniformly spread points waste most of their iterations on orbits that never enter a zoomed view, so the points are instead sampled by Metropolis-Hastings chains in proportion to how much their orbits contribute to the view.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "../include/buddhabrot.h"
+
+//same as PERIOD_EPSILON in mandelbrot.c
+#define BUDDHA_PERIOD_EPSILON 1e-13
+
+//every point of the set lies within this square around 0
+#define BUDDHA_DOMAIN 2.0
+
+//the probability that a step proposes a point anywhere in the set instead of close to the current one, which keeps the chain from getting stuck
+#define BUDDHA_JUMP_PROBABILITY 0.1
+
+//the steps close to the current point have a length between these fractions of the width of the view, spread logarithmically
+#define BUDDHA_STEP_MIN 1e-4
+#define BUDDHA_STEP_MAX 1e-1
+
+//the chains visit the points that contribute in proportion to their contribution plus this floor
+//without it the points with short orbits are visited so rarely, and with such large weights, that the outer parts of a view stay noisy
+#define BUDDHA_CONTRIBUTION_FLOOR 64
+
+//C99 has no M_PI
+#define BUDDHA_TWO_PI 6.283185307179586
+
+/**
+ * @brief Draws a random number with xorshift64*.
+ * @param state The state of the generator, updated by the call.
+ * @return A number with 0 <= r < 1.
+ */
+static inline double buddhaRandom(unsigned long long * state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (double)((*state * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Finds the pixel of the histogram containing a point.
+ * @param v The view.
+ * @param x x-position in the complex-plane.
+ * @param y y-position in the complex-plane.
+ * @return The index of the pixel, or -1 if the point is outside the view.
+ */
+static inline int pixelAt(const buddhaView * v, double x, double y)
+{
+    double px = (x - v->x) / v->w * v->width;
+    double py = (y - v->y) / v->h * v->height;
+
+    if(px < 0.0 || py < 0.0 || px >= v->width || py >= v->height) return -1;
+
+    return (int)py * v->width + (int)px;
+}
+
+/**
+ * @brief Adds an orbit and its mirror image across the real axis to the histogram of a chain.
+ * @param c The chain.
+ * @param v The view.
+ * @param x x-positions of the orbit.
+ * @param y y-positions of the orbit.
+ * @param length The length of the orbit.
+ * @param weight The weight of every position.
+ */
+static void addOrbit(buddhaChain * c, const buddhaView * v, const double * x, const double * y, int length, float weight)
+{
+    for(int a = 0; a < length; a++) {
+        int p = pixelAt(v, x[a], y[a]);
+        if(p >= 0) c->histogram[p] += weight;
+
+        p = pixelAt(v, x[a], -y[a]);
+        if(p >= 0) c->histogram[p] += weight;
+    }
+}
+
+/**
+ * @brief Moves a chain to the point whose orbit is in its proposal buffers.
+ * @param c The chain.
+ * @param cx x-position of the point in the complex-plane.
+ * @param cy y-position of the point in the complex-plane.
+ * @param length The length of the orbit.
+ * @param contribution The contribution of the orbit.
+ */
+static void moveTo(buddhaChain * c, double cx, double cy, int length, int contribution)
+{
+    double * t = c->x;
+    c->x = c->nextX;
+    c->nextX = t;
+    t = c->y;
+    c->y = c->nextY;
+    c->nextY = t;
+
+    c->cx = cx;
+    c->cy = cy;
+    c->length = length;
+    c->contribution = contribution;
+}
+
+/**
+ * @brief Calculates the orbit of a point into the proposal buffers of a chain and moves the chain there if it contributes more, or with the probability given by the ratio of the contributions if it contributes less.
+ * @param c The chain.
+ * @param v The view.
+ * @param nMax The maximum number of iterations.
+ * @param cx x-position of the point in the complex-plane.
+ * @param cy y-position of the point in the complex-plane.
+ */
+static void propose(buddhaChain * c, const buddhaView * v, int nMax, double cx, double cy)
+{
+    if(fabs(cx) > BUDDHA_DOMAIN || fabs(cy) > BUDDHA_DOMAIN) return;
+
+    int length = buddha_orbit(c, cx, cy, nMax, c->nextX, c->nextY);
+    int contribution = buddha_contribution(v, c->nextX, c->nextY, length);
+    if(contribution == 0) return;
+
+    if(contribution < c->contribution && buddhaRandom(&c->random) * (c->contribution + BUDDHA_CONTRIBUTION_FLOOR) >= contribution + BUDDHA_CONTRIBUTION_FLOOR) return;
+
+    moveTo(c, cx, cy, length, contribution);
+}
+
+buddhaChain * buddha_createChain(const buddhaView * v, int nMax, unsigned long long seed)
+{
+    buddhaChain * c = (buddhaChain*) malloc(sizeof(buddhaChain));
+
+    //splitmix64 of the seed, xorshift needs a state that is not 0
+    seed += 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    c->random = (seed ^ (seed >> 31)) | 1;
+
+    c->cx = 0.0;
+    c->cy = 0.0;
+    c->length = 0;
+    c->contribution = 0;
+    c->x = (double*) malloc(sizeof(double) * nMax);
+    c->y = (double*) malloc(sizeof(double) * nMax);
+    c->nextX = (double*) malloc(sizeof(double) * nMax);
+    c->nextY = (double*) malloc(sizeof(double) * nMax);
+    c->histogram = (float*) calloc((size_t)v->width * v->height, sizeof(float));
+    c->iterations = 0;
+    c->cardioidSaved = 0;
+    c->periodSaved = 0;
+
+    return c;
+}
+
+void buddha_destroyChain(buddhaChain * c)
+{
+    free(c->x);
+    free(c->y);
+    free(c->nextX);
+    free(c->nextY);
+    free(c->histogram);
+    free(c);
+}
+
+int buddha_orbit(buddhaChain * c, double cx, double cy, int nMax, double * x, double * y)
+{
+    //same test as inCardioidOrBulb in mandelbrot.c
+    double y2 = cy*cy, xq = cx - 0.25, q = xq*xq + y2;
+    if(q*(q + xq) <= 0.25*y2 || (cx + 1.0)*(cx + 1.0) + y2 <= 0.0625) {
+        c->cardioidSaved += nMax;
+        return 0;
+    }
+
+    double zx = 0.0, zy = 0.0, xTemp = 0.0;
+    double xRef = 0.0, yRef = 0.0;
+    int nextRef = 1;
+
+    for(int n = 0; n < nMax; n++) {
+        xTemp = zx*zx - zy*zy + cx;
+        zy = 2.0*zx*zy + cy;
+        zx = xTemp;
+
+        x[n] = zx;
+        y[n] = zy;
+
+        if(zx*zx + zy*zy > 4.0) {
+            c->iterations += n + 1;
+            return n + 1;
+        }
+
+        if(fabs(zx - xRef) + fabs(zy - yRef) < BUDDHA_PERIOD_EPSILON) {
+            c->iterations += n + 1;
+            c->periodSaved += nMax - n - 1;
+            return 0;
+        }
+
+        if(n + 1 == nextRef) {
+            xRef = zx;
+            yRef = zy;
+            nextRef *= 2;
+        }
+    }
+
+    c->iterations += nMax;
+    return 0;
+}
+
+int buddha_contribution(const buddhaView * v, const double * x, const double * y, int length)
+{
+    int count = 0;
+
+    for(int a = 0; a < length; a++) {
+        count += pixelAt(v, x[a], y[a]) >= 0;
+        count += pixelAt(v, x[a], -y[a]) >= 0;
+    }
+
+    return count;
+}
+
+bool buddha_seed(buddhaChain * c, const buddhaView * v, int nMax, int attempts)
+{
+    for(int a = 0; a < attempts; a++) {
+        double cx, cy;
+
+        if(a % 2 == 0) {
+            cx = v->x + buddhaRandom(&c->random) * v->w;
+            cy = v->y + buddhaRandom(&c->random) * v->h;
+        } else {
+            cx = (2.0*buddhaRandom(&c->random) - 1.0) * BUDDHA_DOMAIN;
+            cy = (2.0*buddhaRandom(&c->random) - 1.0) * BUDDHA_DOMAIN;
+        }
+
+        if(fabs(cx) > BUDDHA_DOMAIN || fabs(cy) > BUDDHA_DOMAIN) continue;
+
+        int length = buddha_orbit(c, cx, cy, nMax, c->nextX, c->nextY);
+        int contribution = buddha_contribution(v, c->nextX, c->nextY, length);
+        if(contribution <= c->contribution) continue;
+
+        moveTo(c, cx, cy, length, contribution);
+    }
+
+    return c->contribution > 0;
+}
+
+void buddha_run(buddhaChain * c, const buddhaView * v, int nMax, long long samples)
+{
+    double stepMin = BUDDHA_STEP_MIN * fabs(v->w), stepMax = BUDDHA_STEP_MAX * fabs(v->w);
+
+    for(long long s = 0; s < samples; s++) {
+        if(c->contribution == 0 || buddhaRandom(&c->random) < BUDDHA_JUMP_PROBABILITY) {
+            propose(c, v, nMax, (2.0*buddhaRandom(&c->random) - 1.0) * BUDDHA_DOMAIN, (2.0*buddhaRandom(&c->random) - 1.0) * BUDDHA_DOMAIN);
+        } else {
+            double r = stepMax * exp(-log(stepMax / stepMin) * buddhaRandom(&c->random));
+            double phi = BUDDHA_TWO_PI * buddhaRandom(&c->random);
+            propose(c, v, nMax, c->cx + r*cos(phi), c->cy + r*sin(phi));
+        }
+
+        //the chain visits points in proportion to their contribution, which the weight cancels
+        if(c->contribution > 0) addOrbit(c, v, c->x, c->y, c->length, 1.0f / (float)(c->contribution + BUDDHA_CONTRIBUTION_FLOOR));
+    }
+}
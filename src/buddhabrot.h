@@ -0,0 +1,95 @@
+/**
+ * @file buddhabrot.h
+ * @date 18/10 2026
+ * @brief Orbit-density rendering of the mandelbrot-set (the buddhabrot), sampled with Metropolis-Hastings chains that each fill a private histogram.
+ */
+
+#ifndef BUDDHABROT_H
+#define BUDDHABROT_H
+
+#include <stdbool.h>
+
+/**
+ * @struct buddhaView
+ * @brief the @ref buddhaView struct is the part of the complex-plane covered by a histogram.
+ */
+typedef struct buddhaView {
+    double x, y; /**< the upper left corner in the complex-plane */
+    double w, h; /**< the size in the complex-plane, h is negative when y grows upwards like in the visualizations */
+    int width, height; /**< the size of the histogram in pixels */
+} buddhaView;
+
+/**
+ * @struct buddhaChain
+ * @brief the @ref buddhaChain struct is a Metropolis-Hastings chain of points whose orbits are added to a histogram. Every chain is used by one thread only, so its histogram needs no locking.
+ */
+typedef struct buddhaChain {
+    unsigned long long random; /**< the state of the random number generator */
+    double cx, cy; /**< the point the chain is at */
+    int length; /**< the length of the orbit of the point */
+    int contribution; /**< the number of positions of the orbit and of its mirror image inside the view, 0 while the chain has no point */
+    double * x, * y; /**< the orbit of the point, nMax values */
+    double * nextX, * nextY; /**< the orbit of the proposed point, nMax values */
+    float * histogram; /**< the histogram of the chain, width*height values */
+    long long iterations; /**< iterations calculated */
+    long long cardioidSaved; /**< iterations saved by rejecting points in the main cardioid or the period-2 bulb */
+    long long periodSaved; /**< iterations saved by periodicity detection */
+} buddhaChain;
+
+/**
+ * @brief Creates a chain with an empty histogram and no point.
+ * @param v The view.
+ * @param nMax The maximum number of iterations.
+ * @param seed The seed of the random number generator, chains with different seeds are independent.
+ * @return A buddhaChain struct.
+ */
+buddhaChain * buddha_createChain(const buddhaView * v, int nMax, unsigned long long seed);
+
+/**
+ * @brief Destroys a chain and its histogram.
+ * @param c The chain.
+ */
+void buddha_destroyChain(buddhaChain * c);
+
+/**
+ * @brief Calculates the orbit of a point that escapes. Points in the main cardioid or the period-2 bulb are rejected without being iterated, and periodic orbits are stopped early.
+ * @param c The chain whose counters are updated.
+ * @param cx x-position of the point in the complex-plane.
+ * @param cy y-position of the point in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @param x Set to the x-positions of the orbit, nMax values.
+ * @param y Set to the y-positions of the orbit, nMax values.
+ * @return The length of the orbit, or 0 if the point does not escape within nMax iterations.
+ */
+int buddha_orbit(buddhaChain * c, double cx, double cy, int nMax, double * x, double * y);
+
+/**
+ * @brief Counts the positions of an orbit and of its mirror image across the real axis that lie inside the view.
+ * @param v The view.
+ * @param x x-positions of the orbit.
+ * @param y y-positions of the orbit.
+ * @param length The length of the orbit.
+ * @return The number of positions inside the view.
+ */
+int buddha_contribution(const buddhaView * v, const double * x, const double * y, int length);
+
+/**
+ * @brief Finds the starting point of a chain, the candidate whose orbit has the most positions inside the view. Half the candidates are taken from the view itself, where every escaping point has at least its first position inside, and half from the whole set.
+ * @param c The chain.
+ * @param v The view.
+ * @param nMax The maximum number of iterations.
+ * @param attempts The number of candidates.
+ * @return true if a candidate contributed to the view.
+ */
+bool buddha_seed(buddhaChain * c, const buddhaView * v, int nMax, int attempts);
+
+/**
+ * @brief Runs a chain. Each step proposes a point close to the current one, or anywhere in the set now and then, and moves there with a probability given by the ratio of their contributions, plus a floor that keeps the short orbits from being starved. The current orbit is added to the histogram after every step, weighted by one over the same sum, so that the histogram is proportional to the density of the orbits of uniformly spread points.
+ * @param c The chain.
+ * @param v The view.
+ * @param nMax The maximum number of iterations.
+ * @param samples The number of steps.
+ */
+void buddha_run(buddhaChain * c, const buddhaView * v, int nMax, long long samples);
+
+#endif // BUDDHABROT_H
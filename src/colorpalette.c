@@ -13,6 +13,7 @@ typedef struct {
     unsigned char ** colors;
     int numColors;
     double colorWrapping;
+    int changes;
 } colorPalette;
 
 colorPalette * color_createPalette(int numColors)
@@ -27,6 +28,7 @@ colorPalette * color_createPalette(int numColors)
     c->colors = colors;
     c->numColors = numColors;
     c->colorWrapping = 15.0;
+    c->changes = 0;
 
     return c;
 }
@@ -45,12 +47,16 @@ void color_setColor(colorPalette * c, unsigned char r, unsigned char g, unsigned
     c->colors[location][0] = r;
     c->colors[location][1] = g;
     c->colors[location][2] = b;
+    c->changes++;
 }
 
-unsigned int color_sample(colorPalette * c, double v)
+int color_getChanges(colorPalette * c)
+{
+    return c->changes;
+}
+
+unsigned int color_sampleOnce(colorPalette * c, double v)
 {
-    v *= c->colorWrapping;
-    v = fmod(v, 1.0);
     double location = ((double)(c->numColors - 1) * v);
 
     if(location >= c->numColors) location = c->numColors - 1;
@@ -81,6 +87,12 @@ unsigned int color_sample(colorPalette * c, double v)
     return red | green | blue | alpha;
 }
 
+unsigned int color_sample(colorPalette * c, double v)
+{
+    v *= c->colorWrapping;
+    return color_sampleOnce(c, fmod(v, 1.0));
+}
+
 unsigned int color_blend(unsigned int * colors, int numColors)
 {
     unsigned int redTot = 0, greenTot = 0, blueTot = 0;
@@ -37,6 +37,13 @@ void color_destroyPalette(colorPalette* c);
  */
 void color_setColor(colorPalette * c, unsigned char r, unsigned char g, unsigned char b, int location);
 
+/**
+ * @brief Gets the number of times a color of the palette has been set, so that an image colored with it can be told to be out of date.
+ * @param c The colorPalette.
+ * @return The number of changes.
+ */
+int color_getChanges(colorPalette * c);
+
 /**
  * @brief Samples the colorPalette-gradient.
  * @param c The colorPalette.
@@ -45,6 +52,14 @@ void color_setColor(colorPalette * c, unsigned char r, unsigned char g, unsigned
  */
 unsigned int color_sample(colorPalette * c, double v);
 
+/**
+ * @brief Samples the colorPalette-gradient without repeating it, so that 0 <= v <= 1 goes through the palette once.
+ * @param c The colorPalette.
+ * @param v A value between 0 <= v <= 1.
+ * @return The interpolated color as a 24-bit rgb int.
+ */
+unsigned int color_sampleOnce(colorPalette * c, double v);
+
 /**
  * @brief Blends a number of colors together into one color.
  * @param colors An array of 24-bit rgb ints.
@@ -0,0 +1,314 @@
+/**
+ * @file doubledouble.c
+ * @date 18/10 2026
+ * @brief Double-double arithmetic. Must be compiled without -ffast-math, since the error-free transformations depend on exact IEEE rounding.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "../include/doubledouble.h"
+
+//number of points iterated together by dd_inBrotList
+#define DD_LANES 4
+
+//2^27 + 1, used to split a double into two halves whose products are exact
+#define DD_SPLITTER 134217729.0
+
+/**
+ * @brief Adds two doubles exactly.
+ * @param a The first term.
+ * @param b The second term.
+ * @return The rounded sum in hi and the rounding error in lo.
+ */
+static inline doubleDouble twoSum(double a, double b)
+{
+    doubleDouble r;
+    r.hi = a + b;
+    double bb = r.hi - a;
+    r.lo = (a - (r.hi - bb)) + (b - bb);
+    return r;
+}
+
+/**
+ * @brief Adds two doubles exactly, given that |a| >= |b|.
+ * @param a The first term.
+ * @param b The second term.
+ * @return The rounded sum in hi and the rounding error in lo.
+ */
+static inline doubleDouble quickTwoSum(double a, double b)
+{
+    doubleDouble r;
+    r.hi = a + b;
+    r.lo = b - (r.hi - a);
+    return r;
+}
+
+/**
+ * @brief Multiplies two doubles exactly.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return The rounded product in hi and the rounding error in lo.
+ */
+static inline doubleDouble twoProd(double a, double b)
+{
+    double t = DD_SPLITTER * a;
+    double aHi = t - (t - a);
+    double aLo = a - aHi;
+    t = DD_SPLITTER * b;
+    double bHi = t - (t - b);
+    double bLo = b - bHi;
+
+    doubleDouble r;
+    r.hi = a * b;
+    r.lo = ((aHi * bHi - r.hi) + aHi * bLo + aLo * bHi) + aLo * bLo;
+    return r;
+}
+
+/**
+ * @brief Adds two doubleDoubles, inlined in the kernel.
+ * @param a The first term.
+ * @param b The second term.
+ * @return a + b
+ */
+static inline doubleDouble add(doubleDouble a, doubleDouble b)
+{
+    doubleDouble s = twoSum(a.hi, b.hi);
+    doubleDouble t = twoSum(a.lo, b.lo);
+    s.lo += t.hi;
+    s = quickTwoSum(s.hi, s.lo);
+    s.lo += t.lo;
+    return quickTwoSum(s.hi, s.lo);
+}
+
+/**
+ * @brief Multiplies two doubleDoubles, inlined in the kernel.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return a * b
+ */
+static inline doubleDouble mul(doubleDouble a, doubleDouble b)
+{
+    doubleDouble p = twoProd(a.hi, b.hi);
+    p.lo += a.hi * b.lo + a.lo * b.hi;
+    return quickTwoSum(p.hi, p.lo);
+}
+
+/**
+ * @brief Squares a doubleDouble, inlined in the kernel.
+ * @param a The doubleDouble.
+ * @return a * a
+ */
+static inline doubleDouble sqr(doubleDouble a)
+{
+    doubleDouble p = twoProd(a.hi, a.hi);
+    p.lo += 2.0 * a.hi * a.lo;
+    return quickTwoSum(p.hi, p.lo);
+}
+
+doubleDouble dd_fromDouble(double a)
+{
+    doubleDouble r;
+    r.hi = a;
+    r.lo = 0.0;
+    return r;
+}
+
+doubleDouble dd_fromString(const char * s)
+{
+    doubleDouble r = dd_fromDouble(0.0);
+    doubleDouble ten = dd_fromDouble(10.0);
+    bool negative = false;
+    int exponent = 0;
+
+    while(isspace((unsigned char)*s)) s++;
+
+    if(*s == '-' || *s == '+') {
+        negative = (*s == '-');
+        s++;
+    }
+
+    //every digit is accumulated exactly as an integer, the decimal point only moves the exponent
+    for(bool afterPoint = false; *s != '\0'; s++) {
+        if(*s == '.' && !afterPoint) {
+            afterPoint = true;
+        } else if(isdigit((unsigned char)*s)) {
+            r = add(mul(r, ten), dd_fromDouble((double)(*s - '0')));
+            if(afterPoint) exponent--;
+        } else {
+            break;
+        }
+    }
+
+    if(*s == 'e' || *s == 'E') {
+        exponent += (int)strtol(s + 1, NULL, 10);
+    }
+
+    doubleDouble scale = dd_fromDouble(1.0);
+    for(int a = 0; a < abs(exponent); a++) scale = mul(scale, ten);
+
+    r = exponent < 0 ? dd_div(r, scale) : mul(r, scale);
+
+    if(negative) {
+        r.hi = -r.hi;
+        r.lo = -r.lo;
+    }
+
+    return r;
+}
+
+double dd_toDouble(doubleDouble a)
+{
+    return a.hi + a.lo;
+}
+
+doubleDouble dd_add(doubleDouble a, doubleDouble b)
+{
+    return add(a, b);
+}
+
+doubleDouble dd_sub(doubleDouble a, doubleDouble b)
+{
+    b.hi = -b.hi;
+    b.lo = -b.lo;
+    return add(a, b);
+}
+
+doubleDouble dd_mul(doubleDouble a, doubleDouble b)
+{
+    return mul(a, b);
+}
+
+doubleDouble dd_sqr(doubleDouble a)
+{
+    return sqr(a);
+}
+
+doubleDouble dd_div(doubleDouble a, doubleDouble b)
+{
+    //long division, each quotient digit is a double
+    double q1 = a.hi / b.hi;
+    doubleDouble r = dd_sub(a, mul(b, dd_fromDouble(q1)));
+    double q2 = r.hi / b.hi;
+    r = dd_sub(r, mul(b, dd_fromDouble(q2)));
+    double q3 = r.hi / b.hi;
+
+    doubleDouble q = quickTwoSum(q1, q2);
+    return add(q, dd_fromDouble(q3));
+}
+
+void dd_inBrotList(const doubleDouble * x0, const doubleDouble * y0, int count, int nMax, double periodEpsilon, ddResult * out)
+{
+    //all lane state is kept in doubles, SSE2 cannot convert packed integers to doubles so mixing them stops vectorization
+    double cxHi[DD_LANES], cxLo[DD_LANES], cyHi[DD_LANES], cyLo[DD_LANES];
+    double xHi[DD_LANES], xLo[DD_LANES], yHi[DD_LANES], yLo[DD_LANES];
+    double xRefHi[DD_LANES], xRefLo[DD_LANES], yRefHi[DD_LANES], yRefLo[DD_LANES];
+    double dx[DD_LANES], dy[DD_LANES];
+    double n[DD_LANES], nextRef[DD_LANES], active[DD_LANES], periodic[DD_LANES];
+    int point[DD_LANES];
+    int next = 0;
+    double limit = (double)nMax;
+
+    for(int l = 0; l < DD_LANES; l++) {
+        cxHi[l] = cxLo[l] = cyHi[l] = cyLo[l] = 0.0;
+        xHi[l] = xLo[l] = yHi[l] = yLo[l] = 0.0;
+        xRefHi[l] = xRefLo[l] = yRefHi[l] = yRefLo[l] = 0.0;
+        dx[l] = dy[l] = 0.0;
+        n[l] = nextRef[l] = active[l] = periodic[l] = 0.0;
+        point[l] = -1;
+    }
+
+    while(true) {
+        int alive = 0;
+
+        //collect the result of every finished lane and load the next point of the list into it
+        for(int l = 0; l < DD_LANES; l++) {
+            if(active[l] != 0.0) {
+                alive++;
+                continue;
+            }
+
+            if(point[l] >= 0) {
+                ddResult * r = &out[point[l]];
+                r->n = (int)n[l];
+                r->x = xHi[l];
+                r->y = yHi[l];
+                r->dx = dx[l];
+                r->dy = dy[l];
+                r->periodic = periodic[l] != 0.0;
+                point[l] = -1;
+            }
+
+            if(next < count) {
+                point[l] = next;
+                cxHi[l] = x0[next].hi;
+                cxLo[l] = x0[next].lo;
+                cyHi[l] = y0[next].hi;
+                cyLo[l] = y0[next].lo;
+                xHi[l] = xLo[l] = yHi[l] = yLo[l] = 0.0;
+                xRefHi[l] = xRefLo[l] = yRefHi[l] = yRefLo[l] = 0.0;
+                dx[l] = dy[l] = 0.0;
+                n[l] = periodic[l] = 0.0;
+                nextRef[l] = 1.0;
+                active[l] = nMax > 0 ? 1.0 : 0.0;
+                alive += nMax > 0;
+                next++;
+            }
+        }
+
+        if(alive == 0) break;
+
+        for(int step = 0; step < 8; step++) {
+            //a finished lane is blended back to its old values, a*new + (1-a)*old is exact when a is 0 or 1
+            for(int l = 0; l < DD_LANES; l++) {
+                double a = active[l];
+                doubleDouble x, y, cx, cy;
+                x.hi = xHi[l];
+                x.lo = xLo[l];
+                y.hi = yHi[l];
+                y.lo = yLo[l];
+                cx.hi = cxHi[l];
+                cx.lo = cxLo[l];
+                cy.hi = cyHi[l];
+                cy.lo = cyLo[l];
+
+                doubleDouble xx = sqr(x);
+                doubleDouble yy = sqr(y);
+                doubleDouble xy = mul(x, y);
+                yy.hi = -yy.hi;
+                yy.lo = -yy.lo;
+                xy.hi *= 2.0;
+                xy.lo *= 2.0;
+
+                doubleDouble xn = add(add(xx, yy), cx);
+                doubleDouble yn = add(xy, cy);
+
+                //the derivative does not need more than double precision
+                double dxn = 2.0*(x.hi*dx[l] - y.hi*dy[l]) + 1.0;
+                double dyn = 2.0*(x.hi*dy[l] + y.hi*dx[l]);
+
+                xHi[l] = a*xn.hi + (1.0 - a)*xHi[l];
+                xLo[l] = a*xn.lo + (1.0 - a)*xLo[l];
+                yHi[l] = a*yn.hi + (1.0 - a)*yHi[l];
+                yLo[l] = a*yn.lo + (1.0 - a)*yLo[l];
+                dx[l] = a*dxn + (1.0 - a)*dx[l];
+                dy[l] = a*dyn + (1.0 - a)*dy[l];
+                n[l] += a;
+
+                double distRef = fabs((xn.hi - xRefHi[l]) + (xn.lo - xRefLo[l])) + fabs((yn.hi - yRefHi[l]) + (yn.lo - yRefLo[l]));
+                double isPeriodic = a * (distRef < periodEpsilon ? 1.0 : 0.0);
+                double atRef = a * (n[l] == nextRef[l] ? 1.0 : 0.0);
+                xRefHi[l] = atRef*xn.hi + (1.0 - atRef)*xRefHi[l];
+                xRefLo[l] = atRef*xn.lo + (1.0 - atRef)*xRefLo[l];
+                yRefHi[l] = atRef*yn.hi + (1.0 - atRef)*yRefHi[l];
+                yRefLo[l] = atRef*yn.lo + (1.0 - atRef)*yRefLo[l];
+                nextRef[l] += atRef*nextRef[l];
+
+                periodic[l] += isPeriodic;
+                a *= (xn.hi*xn.hi + yn.hi*yn.hi < 100.0 ? 1.0 : 0.0);
+                a *= (n[l] < limit ? 1.0 : 0.0);
+                active[l] = a * (1.0 - isPeriodic);
+            }
+        }
+    }
+}
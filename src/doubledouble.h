@@ -0,0 +1,103 @@
+/**
+ * @file doubledouble.h
+ * @date 18/10 2026
+ * @brief Double-double arithmetic, numbers represented as the unevaluated sum of two doubles (about 106 bits of mantissa).
+ */
+
+#ifndef DOUBLEDOUBLE_H
+#define DOUBLEDOUBLE_H
+
+#include <stdbool.h>
+
+/**
+ * @struct doubleDouble
+ * @brief the @ref doubleDouble struct is a number hi + lo where |lo| is at most half an ulp of hi.
+ */
+typedef struct doubleDouble {
+    double hi; /**< the leading part */
+    double lo; /**< the trailing part */
+} doubleDouble;
+
+/**
+ * @struct ddResult
+ * @brief the @ref ddResult struct is the result of iterating one point with dd_inBrotList.
+ */
+typedef struct ddResult {
+    int n; /**< the final iteration-count */
+    double x, y; /**< the position of the point after n iterations */
+    double dx, dy; /**< the derivative of the orbit with respect to the point */
+    bool periodic; /**< if the orbit was found to be periodic before nMax */
+} ddResult;
+
+/**
+ * @brief Converts a double to a doubleDouble.
+ * @param a The double.
+ * @return a as a doubleDouble.
+ */
+doubleDouble dd_fromDouble(double a);
+
+/**
+ * @brief Parses a decimal number such as "-1.768573656315270993281742915329544712934120053" or "1e-20".
+ * @param s The string.
+ * @return The number rounded to double-double precision, 0 if s is not a number.
+ */
+doubleDouble dd_fromString(const char * s);
+
+/**
+ * @brief Rounds a doubleDouble to a double.
+ * @param a The doubleDouble.
+ * @return a as a double.
+ */
+double dd_toDouble(doubleDouble a);
+
+/**
+ * @brief Adds two doubleDoubles.
+ * @param a The first term.
+ * @param b The second term.
+ * @return a + b
+ */
+doubleDouble dd_add(doubleDouble a, doubleDouble b);
+
+/**
+ * @brief Subtracts two doubleDoubles.
+ * @param a The first term.
+ * @param b The second term.
+ * @return a - b
+ */
+doubleDouble dd_sub(doubleDouble a, doubleDouble b);
+
+/**
+ * @brief Multiplies two doubleDoubles.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return a * b
+ */
+doubleDouble dd_mul(doubleDouble a, doubleDouble b);
+
+/**
+ * @brief Squares a doubleDouble.
+ * @param a The doubleDouble.
+ * @return a * a
+ */
+doubleDouble dd_sqr(doubleDouble a);
+
+/**
+ * @brief Divides two doubleDoubles.
+ * @param a The numerator.
+ * @param b The denominator.
+ * @return a / b
+ */
+doubleDouble dd_div(doubleDouble a, doubleDouble b);
+
+/**
+ * @brief Iterates a list of points of the mandelbrot-set in double-double precision. The points are iterated a few at a time in lanes that gcc can vectorize.
+ * @param x0 x-positions in the complex-plane.
+ * @param y0 y-positions in the complex-plane.
+ * @param count The number of points.
+ * @param nMax The maximum number of iterations.
+ * @param periodEpsilon An orbit returning this close to a saved point is considered periodic.
+ * @param out count results, in the same order as the positions.
+ */
+void dd_inBrotList(const doubleDouble * x0, const doubleDouble * y0, int count, int nMax, double periodEpsilon, ddResult * out);
+
+#endif
@@ -0,0 +1,381 @@
+/**
+ * @file fixedpoint.c
+ * @date 18/10 2026
+ * @brief Multi-limb fixed-point arithmetic. The helpers take the number of limbs as an argument, and FIXED_KERNEL instantiates the kernels for each width with a constant number of limbs, so that every loop over the limbs is unrolled at compile time.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
+#include "../include/fixedpoint.h"
+
+//the number of fractional digits read by fixed_fromString, more than 1024 bits can hold
+#define FIXED_MAX_DIGITS 320
+
+/**
+ * @brief Compares the magnitudes of two numbers.
+ * @param a The first number.
+ * @param b The second number.
+ * @param limbs The number of limbs used.
+ * @return 1 if |a| > |b|, -1 if |a| < |b| and 0 if they are equal.
+ */
+static inline int compareLimbs(const fixedNumber * a, const fixedNumber * b, int limbs)
+{
+    for(int k = 0; k < limbs; k++) {
+        if(a->limb[k] != b->limb[k]) return a->limb[k] > b->limb[k] ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Adds two numbers, r may be the same as a or b.
+ * @param r Set to a + b.
+ * @param a The first term.
+ * @param b The second term.
+ * @param limbs The number of limbs used.
+ */
+static inline void addLimbs(fixedNumber * r, const fixedNumber * a, const fixedNumber * b, int limbs)
+{
+    if(a->negative == b->negative) {
+        uint64_t carry = 0;
+        for(int k = limbs - 1; k >= 0; k--) {
+            uint64_t sum = (uint64_t)a->limb[k] + b->limb[k] + carry;
+            r->limb[k] = (uint32_t)sum;
+            carry = sum >> 32;
+        }
+        r->negative = a->negative;
+        return;
+    }
+
+    //the smaller magnitude is subtracted from the larger one, which also gives the sign
+    const fixedNumber * big = a, * small = b;
+    if(compareLimbs(a, b, limbs) < 0) {
+        big = b;
+        small = a;
+    }
+
+    bool negative = big->negative;
+    uint64_t borrow = 0;
+    for(int k = limbs - 1; k >= 0; k--) {
+        uint64_t diff = (uint64_t)big->limb[k] - small->limb[k] - borrow;
+        r->limb[k] = (uint32_t)diff;
+        borrow = (diff >> 32) & 1;
+    }
+    r->negative = negative;
+}
+
+/**
+ * @brief Multiplies two numbers, truncating the product to the same number of limbs. r may be the same as a or b.
+ * @param r Set to a * b.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @param limbs The number of limbs used.
+ */
+static inline void mulLimbs(fixedNumber * r, const fixedNumber * a, const fixedNumber * b, int limbs)
+{
+    //column k collects the products with weight 2^(-32*k), the high half of a product belongs to the column before
+    //one column past the last limb is kept so that its carry is not lost
+    uint64_t column[FIXED_MAX_LIMBS + 1];
+    for(int k = 0; k <= limbs; k++) column[k] = 0;
+
+    for(int i = 0; i < limbs; i++) {
+        for(int j = 0; i + j <= limbs && j < limbs; j++) {
+            uint64_t p = (uint64_t)a->limb[i] * b->limb[j];
+            column[i + j] += (uint32_t)p;
+            if(i + j > 0) column[i + j - 1] += p >> 32;
+        }
+    }
+
+    uint64_t carry = 0;
+    for(int k = limbs; k >= 0; k--) {
+        uint64_t sum = column[k] + carry;
+        if(k < limbs) r->limb[k] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    r->negative = a->negative != b->negative;
+}
+
+/**
+ * @brief Squares a number, every product of two different limbs is calculated once and counted twice.
+ * @param r Set to a * a, r may be the same as a.
+ * @param a The number.
+ * @param limbs The number of limbs used.
+ */
+static inline void sqrLimbs(fixedNumber * r, const fixedNumber * a, int limbs)
+{
+    uint64_t column[FIXED_MAX_LIMBS + 1];
+    for(int k = 0; k <= limbs; k++) column[k] = 0;
+
+    for(int i = 0; i < limbs && 2*i <= limbs; i++) {
+        uint64_t p = (uint64_t)a->limb[i] * a->limb[i];
+        column[2*i] += (uint32_t)p;
+        if(i > 0) column[2*i - 1] += p >> 32;
+
+        for(int j = i + 1; i + j <= limbs && j < limbs; j++) {
+            p = (uint64_t)a->limb[i] * a->limb[j];
+            column[i + j] += 2 * (uint64_t)(uint32_t)p;
+            column[i + j - 1] += 2 * (p >> 32);
+        }
+    }
+
+    uint64_t carry = 0;
+    for(int k = limbs; k >= 0; k--) {
+        uint64_t sum = column[k] + carry;
+        if(k < limbs) r->limb[k] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    r->negative = false;
+}
+
+/**
+ * @brief Rounds a number to a double. Only the first three limbs from the first one that is not 0 are read, which is more than a double can hold.
+ * @param a The number.
+ * @param limbs The number of limbs used.
+ * @return a as a double.
+ */
+static inline double toDoubleLimbs(const fixedNumber * a, int limbs)
+{
+    int first = 0;
+    while(first < limbs && a->limb[first] == 0) first++;
+    if(first == limbs) return 0.0;
+
+    int last = first + 2 < limbs ? first + 2 : limbs - 1;
+    double r = 0.0;
+    for(int k = last; k >= first; k--) r = r * 0x1p-32 + (double)a->limb[k];
+    r = ldexp(r, -32 * first);
+
+    return a->negative ? -r : r;
+}
+
+/**
+ * @brief Divides the magnitude of a number by a small integer.
+ * @param a The number.
+ * @param d The divisor.
+ */
+static void divSmall(fixedNumber * a, uint32_t d)
+{
+    uint64_t rest = 0;
+    for(int k = 0; k < FIXED_MAX_LIMBS; k++) {
+        uint64_t cur = (rest << 32) | a->limb[k];
+        a->limb[k] = (uint32_t)(cur / d);
+        rest = cur % d;
+    }
+}
+
+/**
+ * @brief Multiplies the magnitude of a number by a small integer.
+ * @param a The number.
+ * @param f The factor.
+ */
+static void mulSmall(fixedNumber * a, uint32_t f)
+{
+    uint64_t carry = 0;
+    for(int k = FIXED_MAX_LIMBS - 1; k >= 0; k--) {
+        uint64_t cur = (uint64_t)a->limb[k] * f + carry;
+        a->limb[k] = (uint32_t)cur;
+        carry = cur >> 32;
+    }
+}
+
+/**
+ * @brief Instantiates the kernel for one width. Each width gets its own copy where the number of limbs is a constant.
+ * @param BITS The width, a multiple of 32.
+ */
+#define FIXED_KERNEL(BITS) \
+static int iterate##BITS(const fixedNumber * cx, const fixedNumber * cy, int nMax, double * orbitX, double * orbitY, fixedResult * result) \
+{ \
+    const int limbs = BITS / 32; \
+    fixedNumber x, y, xx, yy, xy; \
+    double fx = 0.0, fy = 0.0, dx = 0.0, dy = 0.0, dxTemp = 0.0; \
+    int n = 0; \
+ \
+    memset(&x, 0, sizeof(fixedNumber)); \
+    memset(&y, 0, sizeof(fixedNumber)); \
+    if(orbitX != NULL) { \
+        orbitX[0] = 0.0; \
+        orbitY[0] = 0.0; \
+    } \
+ \
+    while(n < nMax) { \
+        /* the derivative does not need more than double precision */ \
+        dxTemp = 2.0*(fx*dx - fy*dy) + 1.0; \
+        dy = 2.0*(fx*dy + fy*dx); \
+        dx = dxTemp; \
+ \
+        sqrLimbs(&xx, &x, limbs); \
+        sqrLimbs(&yy, &y, limbs); \
+        mulLimbs(&xy, &x, &y, limbs); \
+        addLimbs(&xy, &xy, &xy, limbs); \
+        addLimbs(&y, &xy, cy, limbs); \
+        yy.negative = true; \
+        addLimbs(&x, &xx, &yy, limbs); \
+        addLimbs(&x, &x, cx, limbs); \
+        n++; \
+ \
+        fx = toDoubleLimbs(&x, limbs); \
+        fy = toDoubleLimbs(&y, limbs); \
+        if(orbitX != NULL) { \
+            orbitX[n] = fx; \
+            orbitY[n] = fy; \
+        } \
+ \
+        if(fx*fx + fy*fy >= 100.0) break; \
+    } \
+ \
+    if(result != NULL) { \
+        result->n = n; \
+        result->x = fx; \
+        result->y = fy; \
+        result->dx = dx; \
+        result->dy = dy; \
+    } \
+    return n; \
+}
+
+FIXED_KERNEL(128)
+FIXED_KERNEL(256)
+FIXED_KERNEL(512)
+FIXED_KERNEL(1024)
+
+/**
+ * @brief Runs the kernel of a width.
+ * @param bits The width, 128, 256, 512 or 1024.
+ * @param cx x-position in the complex-plane.
+ * @param cy y-position in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @param orbitX Set to the x-positions of the orbit if not NULL.
+ * @param orbitY Set to the y-positions of the orbit if not NULL.
+ * @param result Set to the result if not NULL.
+ * @return The final iteration-count.
+ */
+static int iterate(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax, double * orbitX, double * orbitY, fixedResult * result)
+{
+    if(bits <= 128) return iterate128(cx, cy, nMax, orbitX, orbitY, result);
+    if(bits <= 256) return iterate256(cx, cy, nMax, orbitX, orbitY, result);
+    if(bits <= 512) return iterate512(cx, cy, nMax, orbitX, orbitY, result);
+    return iterate1024(cx, cy, nMax, orbitX, orbitY, result);
+}
+
+fixedNumber fixed_fromDouble(double a)
+{
+    fixedNumber r;
+    memset(&r, 0, sizeof(fixedNumber));
+    r.negative = a < 0.0;
+    a = fabs(a);
+
+    //a double has at most 53 significant bits, so a few limbs hold it exactly
+    for(int k = 0; k < FIXED_MAX_LIMBS && a != 0.0; k++) {
+        double whole = floor(a);
+        r.limb[k] = (uint32_t)whole;
+        a = (a - whole) * 0x1p32;
+    }
+
+    return r;
+}
+
+fixedNumber fixed_fromDoubleDouble(doubleDouble a)
+{
+    return fixed_add(fixed_fromDouble(a.hi), fixed_fromDouble(a.lo));
+}
+
+fixedNumber fixed_fromString(const char * s)
+{
+    fixedNumber r;
+    memset(&r, 0, sizeof(fixedNumber));
+    char digits[FIXED_MAX_DIGITS];
+    int numDigits = 0, exponent = 0;
+    uint64_t whole = 0;
+    bool negative = false, afterPoint = false;
+
+    while(isspace((unsigned char)*s)) s++;
+
+    if(*s == '-' || *s == '+') {
+        negative = (*s == '-');
+        s++;
+    }
+
+    for(; *s != '\0'; s++) {
+        if(*s == '.' && !afterPoint) {
+            afterPoint = true;
+        } else if(isdigit((unsigned char)*s)) {
+            if(!afterPoint) whole = whole * 10 + (uint64_t)(*s - '0');
+            else if(numDigits < FIXED_MAX_DIGITS) digits[numDigits++] = (char)(*s - '0');
+        } else {
+            break;
+        }
+    }
+
+    if(*s == 'e' || *s == 'E') {
+        exponent = (int)strtol(s + 1, NULL, 10);
+    }
+
+    //the fraction is built from its last digit, r = (r + digit) / 10, so every step is a division by a small integer
+    for(int a = numDigits - 1; a >= 0; a--) {
+        r.limb[0] = (uint32_t)digits[a];
+        divSmall(&r, 10);
+    }
+    r.limb[0] = (uint32_t)whole;
+
+    for(; exponent > 0; exponent--) mulSmall(&r, 10);
+    for(; exponent < 0; exponent++) divSmall(&r, 10);
+
+    r.negative = negative;
+
+    return r;
+}
+
+double fixed_toDouble(fixedNumber a)
+{
+    return toDoubleLimbs(&a, FIXED_MAX_LIMBS);
+}
+
+fixedNumber fixed_add(fixedNumber a, fixedNumber b)
+{
+    fixedNumber r;
+    addLimbs(&r, &a, &b, FIXED_MAX_LIMBS);
+    return r;
+}
+
+fixedNumber fixed_sub(fixedNumber a, fixedNumber b)
+{
+    fixedNumber r;
+    b.negative = !b.negative;
+    addLimbs(&r, &a, &b, FIXED_MAX_LIMBS);
+    return r;
+}
+
+fixedNumber fixed_mul(fixedNumber a, fixedNumber b)
+{
+    fixedNumber r;
+    mulLimbs(&r, &a, &b, FIXED_MAX_LIMBS);
+    return r;
+}
+
+fixedNumber fixed_sqr(fixedNumber a)
+{
+    fixedNumber r;
+    sqrLimbs(&r, &a, FIXED_MAX_LIMBS);
+    return r;
+}
+
+int fixed_bitsFor(double resolution, double margin)
+{
+    //the first limb is the integer part, so a width of bits has an ulp of 2^(32 - bits)
+    for(int bits = 128; bits < 1024; bits *= 2) {
+        if(resolution >= ldexp(margin, 32 - bits)) return bits;
+    }
+    return 1024;
+}
+
+fixedResult fixed_inBrot(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax)
+{
+    fixedResult r;
+    iterate(bits, cx, cy, nMax, NULL, NULL, &r);
+    return r;
+}
+
+int fixed_orbit(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax, double * x, double * y)
+{
+    return iterate(bits, cx, cy, nMax, x, y, NULL);
+}
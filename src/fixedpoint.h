@@ -0,0 +1,125 @@
+/**
+ * @file fixedpoint.h
+ * @date 18/10 2026
+ * @brief Multi-limb fixed-point arithmetic for zooms too deep for double-double. A number is a sign and up to FIXED_MAX_LIMBS 32-bit limbs, where the first limb is the integer part and the rest are the fraction.
+ */
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "doubledouble.h"
+
+//the widest format, 1024 bits
+#define FIXED_MAX_LIMBS 32
+
+/**
+ * @struct fixedNumber
+ * @brief the @ref fixedNumber struct is a number in the widest format. The kernels only use as many limbs as their width needs.
+ */
+typedef struct fixedNumber {
+    bool negative; /**< the sign */
+    uint32_t limb[FIXED_MAX_LIMBS]; /**< the magnitude, limb[k] has the weight 2^(-32*k) */
+} fixedNumber;
+
+/**
+ * @struct fixedResult
+ * @brief the @ref fixedResult struct is the result of iterating one point with fixed_inBrot.
+ */
+typedef struct fixedResult {
+    int n; /**< the final iteration-count */
+    double x, y; /**< the position of the point after n iterations */
+    double dx, dy; /**< the derivative of the orbit with respect to the point */
+} fixedResult;
+
+/**
+ * @brief Converts a double to a fixedNumber.
+ * @param a The double, |a| must be less than 2^32.
+ * @return a as a fixedNumber.
+ */
+fixedNumber fixed_fromDouble(double a);
+
+/**
+ * @brief Converts a doubleDouble to a fixedNumber.
+ * @param a The doubleDouble, |a| must be less than 2^32.
+ * @return a as a fixedNumber.
+ */
+fixedNumber fixed_fromDoubleDouble(doubleDouble a);
+
+/**
+ * @brief Parses a decimal number such as "-1.768573656315270993281742915329544712934120053" or "1e-20".
+ * @param s The string.
+ * @return The number truncated to 1024 bits, 0 if s is not a number.
+ */
+fixedNumber fixed_fromString(const char * s);
+
+/**
+ * @brief Rounds a fixedNumber to a double.
+ * @param a The fixedNumber.
+ * @return a as a double.
+ */
+double fixed_toDouble(fixedNumber a);
+
+/**
+ * @brief Adds two fixedNumbers in the widest format.
+ * @param a The first term.
+ * @param b The second term.
+ * @return a + b
+ */
+fixedNumber fixed_add(fixedNumber a, fixedNumber b);
+
+/**
+ * @brief Subtracts two fixedNumbers in the widest format.
+ * @param a The first term.
+ * @param b The second term.
+ * @return a - b
+ */
+fixedNumber fixed_sub(fixedNumber a, fixedNumber b);
+
+/**
+ * @brief Multiplies two fixedNumbers in the widest format.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return a * b, truncated.
+ */
+fixedNumber fixed_mul(fixedNumber a, fixedNumber b);
+
+/**
+ * @brief Squares a fixedNumber in the widest format, with about half the multiplications of fixed_mul.
+ * @param a The fixedNumber.
+ * @return a * a, truncated.
+ */
+fixedNumber fixed_sqr(fixedNumber a);
+
+/**
+ * @brief Chooses the narrowest width (128, 256, 512 or 1024 bits) that can resolve a distance.
+ * @param resolution The smallest distance that has to be resolved, such as the size of a pixel.
+ * @param margin How many units in the last place the distance must be at least.
+ * @return The number of bits, 1024 if no width is enough.
+ */
+int fixed_bitsFor(double resolution, double margin);
+
+/**
+ * @brief Iterates a point of the mandelbrot-set in fixed-point.
+ * @param bits The width, 128, 256, 512 or 1024.
+ * @param cx x-position in the complex-plane.
+ * @param cy y-position in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @return The final iteration-count, the position and the derivative of the orbit.
+ */
+fixedResult fixed_inBrot(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax);
+
+/**
+ * @brief Iterates a point of the mandelbrot-set in fixed-point, saving its orbit rounded to doubles, for use as a reference orbit.
+ * @param bits The width, 128, 256, 512 or 1024.
+ * @param cx x-position in the complex-plane.
+ * @param cy y-position in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @param x nMax + 1 values, set to the x-positions of the orbit starting with 0.
+ * @param y nMax + 1 values, set to the y-positions of the orbit starting with 0.
+ * @return The number of iterations before the point escaped, or nMax.
+ */
+int fixed_orbit(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax, double * x, double * y);
+
+#endif
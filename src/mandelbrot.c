@@ -5,6 +5,14 @@
  * @brief A concurrent mandelbrot-set visualizer using a threadpool.
  */
 
+//clock_gettime is POSIX, anonymous mappings and huge page advice are not
+#define _POSIX_C_SOURCE 200112L
+#define _DEFAULT_SOURCE
+
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <float.h>
 #include "../include/mandelbrot.h"
 
 //private structs and functions
@@ -13,6 +21,136 @@ unsigned int COLOR_BLACK = 0 | (255 << 24);
 unsigned int COLOR_WHITE = 0 | (255 << 0) | (255 << 8) | (255 << 16) | (255 << 24);
 unsigned int COLOR_GREEN = 0 | (255 << 8) | (255 << 24);
 
+//an orbit returning this close to a saved point is considered periodic, or closer if the pixels are small, see periodEpsilon
+#define PERIOD_EPSILON 1e-13
+
+//the distance at which an orbit is considered periodic is at most this fraction of a pixel, so that the slowly escaping points close to the boundary of a deep zoom are not taken for periodic ones
+#define PERIOD_EPSILON_PIXELS 1e-3
+
+//an orbit whose derivative with respect to z gets this small (squared) is considered attracted by a cycle
+#define INTERIOR_EPSILON 1e-12
+
+//single precision counterpart of PERIOD_EPSILON, also lowered by periodEpsilon
+#define PERIOD_EPSILON_F 1e-6f
+
+//number of points iterated together by the lane kernels, 8 is also the number of anti-aliasing samples taken per round
+#define BROT_LANES 8
+
+//a precision is used only if a pixel is at least this many units in the last place of the coordinates
+#define PRECISION_MARGIN 512.0
+
+//2^-104, the relative precision of a doubleDouble
+#define DOUBLEDOUBLE_EPSILON 4.930380657631324e-32
+
+//the number of new references a list kernel may compute for its glitched points before it falls back to double-double
+#define PERTURB_MAX_REFERENCES 4
+
+//the largest error of the series approximation, in pixels, that is accepted when skipping iterations
+#define SERIES_TOLERANCE 1e-6
+
+//rectangle checking iterates parts of a rectangle narrower than this many pixels directly
+#define RECTANGLE_MIN_SIZE 6
+
+//a pixel is anti-aliased when a color channel differs this much from a neighbor
+#define AA_COLOR_THRESHOLD 32
+
+//a pixel is also anti-aliased when its iteration-count differs this much from a neighbor, even if the palette happens to give similar colors
+#define AA_COUNT_THRESHOLD 16
+
+//the sampling of a pixel stops when a round of samples moves its mean color less than this in every channel
+#define AA_CONVERGED 8
+
+//in the distance render mode, points closer to the set than this many pixels are darkened
+#define DISTANCE_SHADE_PIXELS 1.0
+
+//rows are mirrored when the real axis is this close, in rows, to a row or the middle between two rows
+#define MIRROR_TOLERANCE 1e-3
+
+//the automatic iteration cap is chosen from a probe of this many points squared, spread over the view
+#define AUTO_PROBE_SIZE 48
+
+//the automatic iteration cap is the smallest one that leaves at most this fraction of the probe escaping after it
+#define AUTO_UNRESOLVED_FRACTION 0.002
+
+//the escape radius of the formula kernels, squared
+#define FORMULA_ESCAPE_RADIUS2 100.0
+
+//the number of candidates tried when looking for the starting point of a buddhabrot chain
+#define BUDDHA_SEED_ATTEMPTS 1000
+
+//the densities of a buddhabrot are scaled so that this quantile of the pixels gets the brightest color, a few pixels close to the bulbs are far denser than the rest
+#define BUDDHA_WHITE_QUANTILE 0.999
+
+//the quantile is taken from this many pixels spread over the image
+#define BUDDHA_QUANTILE_SAMPLES 4096
+
+//the brightest color of a buddhabrot is this point of the palette, the middle of the palettes of the program is their brightest color
+#define BUDDHA_PALETTE_RANGE 0.5
+
+//the histograms of the buddhabrot chains that run at the same time take at most this many bytes, or one histogram if it is larger
+#define BUDDHA_HISTOGRAM_BYTES ((size_t)1 << 30)
+
+//the block size of the first pass of a realtime frame, in pixels, a power of 2
+#define REALTIME_FIRST_STEP 8
+
+//the image is divided into tiles of this many pixels squared, pulled by the threads one at a time
+#define TILE_SIZE 128
+
+//the tiled layout of the image stores it in blocks of this many pixels squared, a power of 2 that divides TILE_SIZE
+#define TILED_BLOCK 64
+
+//the tiles that are too expensive to be one job split themselves into quarters, down to this many pixels squared
+#define TILE_MIN_SIZE 16
+
+//the cost of a quarter of a tile is estimated from a grid of this many probe points squared, one point rarely tells the cost of a part on the border of the set
+#define COST_PROBES 2
+
+//the cost of a pixel besides its iterations, in iterations, mostly its coloring
+#define COST_PIXEL_OVERHEAD 128
+
+//the pixel buffers are aligned to and sized in multiples of this, the size of a transparent huge page on x86-64
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+//the first pass of a render with a time budget calculates blocks of this many pixels squared, a power of 2 that divides TILE_SIZE
+#define BUDGET_FIRST_STEP 16
+
+//a render with a time budget lowers the iteration cap to reach full resolution in time, down to the cap divided by this
+#define BUDGET_MAX_CAP_DIVISOR 8
+
+//the iteration cap of a render with a time budget is planned from a grid of this many probe points squared
+#define BUDGET_PROBE_SIZE 16
+
+//the probe of a render with a time budget raises its cap while the next probe is estimated to take at most this part of the time left
+#define BUDGET_PROBE_SHARE 0.0625
+
+//the passes of a render with a time budget check the deadline after every this many pixels of a row
+#define BUDGET_CHUNK 32
+
+//the tiles split themselves until their estimated cost is at most the total divided by this many jobs per thread
+#define JOBS_PER_THREAD 16
+
+//the calibration of a profile renders its scenes at the size of the resolution class, but with sides of at most this many pixels
+#define TUNE_MAX_SIDE 8192
+
+//the iteration caps of the calibration scenes are for this many pixels, and lowered for larger classes so that the calibration takes about as long for every class
+#define TUNE_SCENE_PIXELS (256 * 256)
+
+//the lowest iteration cap the calibration scenes are lowered to
+#define TUNE_MIN_ITERATIONS 64
+
+//the split of the anti-aliasing pass when the profile has none, and the one the calibration starts from
+#define TUNE_DEFAULT_SPLIT 8
+
+//every setting tried by the calibration is timed as the fastest of this many renders of each scene
+#define TUNE_REPEATS 2
+
+//the longest line of a profile file
+#define PROFILE_LINE_LENGTH 256
+
+//the range of the automatic iteration cap
+#define AUTO_MIN_ITERATIONS 128
+#define AUTO_MAX_ITERATIONS (1 << 20)
+
 /**
  * @struct rectangle
  * @brief A rectangle.
@@ -21,6 +159,16 @@ typedef struct rectangle {
     double x, y, w ,h;
 } rectangle;
 
+/**
+ * @struct renderProfile
+ * @brief The settings of the renders tuned for a host and a resolution class, as stored in a profile file.
+ */
+typedef struct renderProfile {
+    int threads; /**< the number of threads */
+    int jobsPerThread; /**< the tiles split themselves until their estimated cost is at most the total divided by this many jobs per thread */
+    int split; /**< the square root of the number of jobs of the anti-aliasing pass */
+} renderProfile;
+
 /**
  * @struct mandelData
  * @brief Struct containing settings for a visualization.
@@ -31,17 +179,112 @@ struct mandelData {
     int width, height;
     colorPalette * c;
     unsigned int * image;
+    doubleDouble originX, originY;
+    fixedNumber centerX, centerY;
+    int fixedBits;
+    bool interiorDetection;
+    bool perturbation;
+    bool seriesApproximation;
+    bool rectangleChecking;
+    bool autoIterations;
+    mandelFormula formula;
+    int power;
+    double juliaX, juliaY;
+    int antiAliasSamples;
+    mandelRenderMode renderMode;
+    int buddhabrotSamples;
+    int mirrorAxis, mirrorStart, mirrorEnd;
+    bool tiledLayout; /**< the image and counts are stored in blocks of TILED_BLOCK*TILED_BLOCK pixels instead of row by row */
+    int * counts;
+    struct resumePoint * resume;
+    int resumeCount, resumeIterations;
+    int * aliasedPixels; /**< the pixels supersampled by the last anti-aliasing pass of a render that can be resumed */
+    unsigned int * aliasedColors; /**< the colors of those pixels before the pass */
+    int aliasedCount;
+    refOrbit * reference;
+    mandelPrecision precision;
+    mandelStats stats;
+    pthread_mutex_t statsLock;
+    struct threadpool * pool; /**< the threads of the renders, kept from one render to the next */
+    int poolThreads;
+    bool pinThreads; /**< the threads of the pool are pinned to the cpus of their NUMA nodes */
+    int * tileThreads; /**< the thread each tile is given to, the one that first wrote its rows and so owns their pages */
+    mandelRegionQuality * quality; /**< the quality of every tile of the last render with a time budget */
+    int qualityCount;
+    char * profilePath; /**< the profile file of the renders with MANDEL_AUTO, NULL for MANDEL_PROFILE_FILE */
+    renderProfile profile; /**< the settings used for MANDEL_AUTO, read by the first render that needs them */
+    bool profileLoaded;
 };
 
+/**
+ * @struct pixelRect
+ * @brief A rectangle of pixels in screen-coordinates.
+ */
+typedef struct pixelRect {
+    int x, y, w, h;
+} pixelRect;
+
 /**
  * @struct mandelJobArg
  * @brief Struct used to pass arguments to the threadpool.
  */
 typedef struct mandelJobArg {
-    rectangle calcLocation;
+    pixelRect tile;
+    pixelRect quarters[4]; /**< the quarters of the tile, the ones past the edge of the image have no pixels */
+    double quarterCosts[4]; /**< the estimated costs of the quarters, in iterations */
+    bool probed; /**< if the quarters have been probed */
+    int key; /**< the index of the tile in the image, -1 for a quarter */
+    double cost; /**< the estimated cost of the tile, in iterations */
+    double target; /**< tiles estimated to cost more than this split themselves */
+    struct mandelJobArg * merged; /**< the next cheap tile calculated by this job, NULL if none */
+    struct threadpool * pool;
     mandelData * data;
 } mandelJobArg;
 
+/**
+ * @struct mirrorJobArg
+ * @brief Struct used to pass a range of rows to be mirrored to the threadpool.
+ */
+typedef struct mirrorJobArg {
+    mandelData * data;
+    int first; /**< the first row */
+    int last; /**< the last row */
+} mirrorJobArg;
+
+/**
+ * @struct antiAliasJobArg
+ * @brief Struct used to pass a part of the pixels to be anti-aliased to the threadpool.
+ */
+typedef struct antiAliasJobArg {
+    mandelData * data;
+    const int * pixels;
+    int count;
+    double deadline; /**< the job stops taking samples at this time, from monotonicSeconds */
+    bool * cut; /**< set if the job was stopped by the deadline */
+} antiAliasJobArg;
+
+/**
+ * @struct buddhaJobArg
+ * @brief Struct used to pass a buddhabrot chain to the threadpool.
+ */
+typedef struct buddhaJobArg {
+    mandelData * data;
+    buddhaChain * chain;
+    buddhaView view;
+    long long samples;
+} buddhaJobArg;
+
+/**
+ * @struct buddhaMergeJobArg
+ * @brief Struct used to pass a band of rows of the buddhabrot histograms to be merged to the threadpool.
+ */
+typedef struct buddhaMergeJobArg {
+    buddhaChain ** chains;
+    int numChains;
+    float * density;
+    int from, to; /**< the range of pixels */
+} buddhaMergeJobArg;
+
 /**
  * @struct brotStruct.
  * @brief internal struct.
@@ -50,8 +293,30 @@ typedef struct {
     int n;
     double x;
     double y;
+    double dist;
+    double dx, dy; /**< the derivative of the orbit with respect to the point, only kept by the kernels that can be resumed */
 } brotStruct;
 
+/**
+ * @struct resumePoint
+ * @brief A pixel that reached the iteration cap of the last render, with the state its orbit can be continued from.
+ */
+typedef struct resumePoint {
+    int pixel; /**< the index of the pixel in the image, -1 once it has escaped */
+    double cx, cy; /**< the point in the complex-plane */
+    brotStruct b; /**< the orbit when it stopped */
+} resumePoint;
+
+/**
+ * @struct resumeJobArg
+ * @brief Struct used to pass a part of the pixels to be continued to the threadpool.
+ */
+typedef struct resumeJobArg {
+    mandelData * data;
+    resumePoint * points;
+    int count;
+} resumeJobArg;
+
 /**
  * @struct threadArgs.
  * @brief internal struct.
@@ -63,66 +328,336 @@ struct threadArgs {
 };
 
 /**
- * @brief Divides a rectangle into smaller rectangles.
- * @param rect A rectangle that is to be divided.
- * @param split Divides rect into split*split pieces. All pieces will be the same size.
- * @return An array of smaller rectangles.
+ * @brief A kernel that iterates a list of points given as offsets from the upper left corner of the visualization.
+ */
+typedef void (*listKernel)(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats);
+
+/**
+ * @struct realtimeWorker
+ * @brief A thread of a realtime renderer and the buffers it reuses for every row.
+ */
+typedef struct realtimeWorker {
+    struct mandelRealtime * r;
+    double * ox, * oy; /**< the positions of a row, width values */
+    brotStruct * cells; /**< the results of a row, width values */
+    mandelStats stats;
+} realtimeWorker;
+
+/**
+ * @struct mandelRealtime
+ * @brief A realtime renderer. Its workers run as long-lived jobs of its own threadpool, waiting for a frame between the frames.
+ */
+struct mandelRealtime {
+    mandelData * m;
+    struct threadpool * pool;
+    int numthreads;
+    realtimeWorker * workers;
+    pthread_mutex_t lock;
+    pthread_cond_t start; /**< signaled when a frame starts or the renderer is destroyed */
+    pthread_cond_t done; /**< signaled when the last worker is done with a frame */
+    pthread_cond_t passDone; /**< signaled when the last row of a pass is done */
+    int frame; /**< the number of frames started */
+    int working; /**< the number of workers still on the current frame */
+    bool quit;
+    double deadline; /**< the end of the current frame, from monotonicSeconds */
+    int step; /**< the block size of the current pass, 0 when the image is complete */
+    int nextRow; /**< the next row of the current pass */
+    int inFlight; /**< the number of rows of the current pass being calculated */
+    listKernel kernel;
+    rectangle location; /**< the view the passes were started for */
+    int iterations; /**< the iteration cap the passes were started for */
+    mandelFormula formula; /**< the formula the passes were started for */
+    int power; /**< the power the passes were started for */
+    double juliaX, juliaY; /**< the julia seed the passes were started for */
+    mandelRenderMode renderMode; /**< the render mode the passes were started for */
+    bool interiorDetection; /**< if the passes were started with interior detection */
+    int paletteChanges; /**< the changes of the palette when the passes were started, from color_getChanges */
+};
+
+/**
+ * @struct budgetJobArg
+ * @brief Struct used to pass a tile to the threadpool for a pass of a render with a time budget. The same struct is used by every pass over the tile.
+ */
+typedef struct budgetJobArg {
+    mandelData * data;
+    pixelRect tile;
+    int key; /**< the index of the tile in the image */
+    listKernel kernel;
+    int step; /**< the block size of the pass */
+    double deadline; /**< the pass starts no chunk of BUDGET_CHUNK pixels of the tile after this time, from monotonicSeconds */
+    int reached; /**< the block size of the finest pass that calculated every row of the tile, 0 if no pass did */
+    long long samples; /**< the number of pixels iterated by the pass */
+} budgetJobArg;
+
+/**
+ * @struct tileData
+ * @brief A rectangle being calculated with a list kernel, and the results of its pixels.
+ */
+typedef struct tileData {
+    mandelData * m;
+    int xScreen, yScreen; /**< the upper left corner in screen-coordinates */
+    int columns, rows; /**< the number of pixels */
+    listKernel kernel;
+    brotStruct * cells; /**< the results of the pixels, row by row */
+    mandelStats * stats;
+} tileData;
+
+/**
+ * @brief The state of a pixel during rectangle checking.
+ */
+enum cellState {
+    CELL_EMPTY,
+    CELL_ITERATED,
+    CELL_FILLED
+};
+
+/**
+ * @brief Gets the x-position of a column of a rectangle.
+ * @param t The rectangle.
+ * @param c The column.
+ * @return The position, as an offset from the upper left corner of the visualization.
  */
-rectangle ** divideRectangle(rectangle rect, int split)
+static inline double tileX(const tileData * t, int c)
 {
-    //create a 2d-array of size split*split
-    rectangle ** subRects = (rectangle**) malloc(sizeof(rectangle*) * split);
-    for(int a = 0; a < split; a++) {
-        subRects[a] = (rectangle*) malloc(sizeof(rectangle) * split);
-    }
+    return (double)(t->xScreen + c)/(double)t->m->width*t->m->location.w;
+}
+
+/**
+ * @brief Gets the y-position of a row of a rectangle.
+ * @param t The rectangle.
+ * @param r The row.
+ * @return The position, as an offset from the upper left corner of the visualization.
+ */
+static inline double tileY(const tileData * t, int r)
+{
+    return (double)(t->yScreen + r)/(double)t->m->height*t->m->location.h;
+}
+
+/**
+ * @brief Gets the index of a pixel of a rectangle in its cells. The cells are stored row by row, like the image, so that a row of the rectangle is written to the image as one run of memory.
+ * @param t The rectangle.
+ * @param c The column.
+ * @param r The row.
+ * @return The index.
+ */
+static inline int cellIndex(const tileData * t, int c, int r)
+{
+    return r * t->columns + c;
+}
+
+/**
+ * @brief Gets the index of a pixel in the image and counts of a visualization. In the tiled layout every block of TILED_BLOCK*TILED_BLOCK pixels is stored row by row, and the blocks one after another in the order of the image, so the pixels a tile works on stay together in the caches.
+ * @param m The settings of the visualization.
+ * @param x The column of the pixel.
+ * @param y The row of the pixel.
+ * @return The index.
+ */
+static inline int pixelOffset(const mandelData * m, int x, int y)
+{
+    if(!m->tiledLayout) return y * m->width + x;
+
+    int blocks = (m->width + TILED_BLOCK - 1) / TILED_BLOCK;
+    return ((y / TILED_BLOCK * blocks + x / TILED_BLOCK) * TILED_BLOCK + y % TILED_BLOCK) * TILED_BLOCK + x % TILED_BLOCK;
+}
+
+/**
+ * @brief Gets the index in the image and counts of a pixel given by its index in a row by row image, as the pixels are kept in lists.
+ * @param m The settings of the visualization.
+ * @param a The index of the pixel in a row by row image.
+ * @return The index.
+ */
+static inline int indexOffset(const mandelData * m, int a)
+{
+    return m->tiledLayout ? pixelOffset(m, a % m->width, a / m->width) : a;
+}
 
-    double subRectWidth = rect.w / (double)split;
-    double subRectHeight = rect.h / (double)split;
+/**
+ * @brief Gets how many pixels of a row, starting at a pixel, are stored one after another in the image and counts.
+ * @param m The settings of the visualization.
+ * @param x The column of the first pixel.
+ * @param count The number of pixels wanted.
+ * @return The number of pixels from x that can be written as one run, at most count.
+ */
+static inline int pixelRun(const mandelData * m, int x, int count)
+{
+    if(!m->tiledLayout || count <= TILED_BLOCK - x % TILED_BLOCK) return count;
+    return TILED_BLOCK - x % TILED_BLOCK;
+}
 
-    //split rect and put the smaller rectangles into subRects
-    for(int x = 0; x < split; x++) {
-        for(int y = 0; y < split; y++) {
-            rectangle r;
-            r.x = rect.x + subRectWidth * (double)x;
-            r.y = rect.y + subRectHeight * (double)y;
-            r.w = subRectWidth;
-            r.h = subRectHeight;
+/**
+ * @brief Gets the number of pixels stored in the image and counts of a visualization, including the parts of the blocks of the tiled layout that are outside the image.
+ * @param m The settings of the visualization.
+ * @return The number of pixels.
+ */
+static inline size_t pixelStorage(const mandelData * m)
+{
+    if(!m->tiledLayout) return (size_t)m->width * m->height;
+    return (size_t)((m->width + TILED_BLOCK - 1) / TILED_BLOCK * TILED_BLOCK) * ((m->height + TILED_BLOCK - 1) / TILED_BLOCK * TILED_BLOCK);
+}
 
-            subRects[x][y] = r;
+/**
+ * @brief Finds the point at a distance along a Hilbert curve filling a square.
+ * @param n The side of the square, a power of 2.
+ * @param d The distance along the curve, from 0 to n*n - 1.
+ * @param x Set to the column of the point.
+ * @param y Set to the row of the point.
+ */
+void hilbertPoint(int n, int d, int * x, int * y)
+{
+    *x = 0;
+    *y = 0;
+
+    for(int s = 1; s < n; s *= 2) {
+        int rx = 1 & (d / 2);
+        int ry = 1 & (d ^ rx);
+
+        //each quadrant is the curve of the level below, rotated so that the quadrants join up
+        if(ry == 0) {
+            if(rx == 1) {
+                *x = s - 1 - *x;
+                *y = s - 1 - *y;
+            }
+            int t = *x;
+            *x = *y;
+            *y = t;
         }
+
+        *x += s * rx;
+        *y += s * ry;
+        d /= 4;
+    }
+}
+
+/**
+ * @brief Divides the image into tiles of TILE_SIZE*TILE_SIZE pixels, the last ones in each row and column cut at the edge. The tiles do not overlap, and they are ordered along a Hilbert curve, so that tiles calculated at about the same time are close to each other in the image.
+ * @param m The settings of the visualization.
+ * @param count Set to the number of tiles.
+ * @return The tiles.
+ */
+pixelRect * divideImage(mandelData * m, int * count)
+{
+    int columns = (m->width + TILE_SIZE - 1) / TILE_SIZE;
+    int rows = (m->height + TILE_SIZE - 1) / TILE_SIZE;
+    int n = 1;
+    while(n < columns || n < rows) n *= 2;
+
+    pixelRect * tiles = (pixelRect*) malloc(sizeof(pixelRect) * columns * rows);
+    *count = 0;
+
+    //the curve fills the smallest power of 2 square around the tiles, and the points outside the image are skipped
+    for(int d = 0; d < n * n; d++) {
+        int c, r;
+        hilbertPoint(n, d, &c, &r);
+        if(c >= columns || r >= rows) continue;
+
+        pixelRect * t = &tiles[(*count)++];
+        t->x = c * TILE_SIZE;
+        t->y = r * TILE_SIZE;
+        t->w = m->width - t->x < TILE_SIZE ? m->width - t->x : TILE_SIZE;
+        t->h = m->height - t->y < TILE_SIZE ? m->height - t->y : TILE_SIZE;
     }
 
-    return subRects;
+    return tiles;
+}
+
+/**
+ * @brief Gets the distance at which an orbit is considered periodic for a visualization. The distance is scaled down with the pixels, as an absolute one takes the slowly escaping points of a deep zoom for interior ones.
+ * @param m The settings of the visualization.
+ * @param limit The distance used for large pixels, PERIOD_EPSILON or PERIOD_EPSILON_F depending on the precision.
+ * @return The smaller of limit and PERIOD_EPSILON_PIXELS of a pixel.
+ */
+double periodEpsilon(mandelData * m, double limit)
+{
+    return fmin(limit, fabs(m->location.w) / (double)m->width * PERIOD_EPSILON_PIXELS);
+}
+
+/**
+ * @brief Checks analytically if a point lies in the main cardioid or the period-2 bulb of the mandelbrot-set.
+ * @param x0 x-position in the complex-plane.
+ * @param y0 y-position in the complex-plane.
+ * @return true if the point is inside one of them and therefore never escapes.
+ */
+bool inCardioidOrBulb(double x0, double y0)
+{
+    double y2 = y0*y0;
+    double xq = x0 - 0.25;
+    double q = xq*xq + y2;
+
+    if(q*(q + xq) <= 0.25*y2) return true;
+
+    return (x0 + 1.0)*(x0 + 1.0) + y2 <= 0.0625;
 }
 
 /**
  * @brief Checks if a points is in the mandelbrot-set or not.
- * @param fx x-position in the complex-plane.
- * @param fy y-position in the complex-plane.
+ * @param x0 x-position in the complex-plane.
+ * @param y0 y-position in the complex-plane.
  * @param nMax the maximum number of iterations.
+ * @param interiorCheck If the derivative of the orbit should be used to detect interior points early.
+ * @param epsilon An orbit returning this close to a saved point is considered periodic, from periodEpsilon.
+ * @param stats Iteration counters that are updated by the call.
  * @return A struct containing the final iteration-count n, and the position of the point after n iterations.
  */
-brotStruct inBrot(double x0, double y0, int nMax)
+brotStruct inBrot(double x0, double y0, int nMax, bool interiorCheck, double epsilon, mandelStats * stats)
 {
-    int i = 0;
+    int i = 0, nextRef = 1;
+    bool interior = false;
     double x = 0.0, y = 0.0, xTemp = -1.0, yTemp = -1.0;
+    double xRef = 0.0, yRef = 0.0;
+    double dzx = 1.0, dzy = 0.0, dzxTemp = 0.0;
+
+    brotStruct b;
+    b.n = nMax;
+    b.x = x0;
+    b.y = y0;
+    b.dist = -1;
+    b.dx = 0.0;
+    b.dy = 0.0;
+
+    if(inCardioidOrBulb(x0, y0)) {
+        stats->cardioidSaved += nMax;
+        return b;
+    }
 
     while(x*x+y*y < 100.0 && i < nMax) {
         xTemp = x*x - y*y + x0;
         yTemp = 2.0*x*y + y0;
 
-        if(xTemp == x && yTemp == y) {
-            i = nMax;
-            break;
-        }
-
         x = xTemp;
         y = yTemp;
 
         i++;
+
+        //the orbit has returned to the point saved at the last power of two, so it is periodic
+        if(fabs(x - xRef) + fabs(y - yRef) < epsilon) {
+            stats->periodSaved += nMax - i;
+            interior = true;
+            break;
+        }
+
+        if(i == nextRef) {
+            xRef = x;
+            yRef = y;
+            nextRef *= 2;
+        }
+
+        //the derivative with respect to z shrinks towards zero for orbits attracted by a cycle
+        if(interiorCheck) {
+            dzxTemp = 2.0*(x*dzx - y*dzy);
+            dzy = 2.0*(x*dzy + y*dzx);
+            dzx = dzxTemp;
+
+            if(dzx*dzx + dzy*dzy < INTERIOR_EPSILON) {
+                stats->derivativeSaved += nMax - i;
+                interior = true;
+                break;
+            }
+        }
     }
 
-    brotStruct b;
+    stats->iterations += i;
+    if(interior) i = nMax;
+
     b.n = i;
     b.x = x;
     b.y = y;
@@ -131,219 +666,2867 @@ brotStruct inBrot(double x0, double y0, int nMax)
 }
 
 /**
- * @brief Does a fast and approximate distance-estimation from the give coordinate to the mandelbrot-set.
- * @param fx x-position in the complex-plane.
- * @param fy y-position in the complex-plane.
- * @return The estimated distance.
-*/
-double mandelDist(double x0, double y0)
+ * @brief Continues the orbit of a point while tracking its derivative, from where an earlier call stopped. Periodicity detection starts over from the first position.
+ * @param x0 x-position in the complex-plane.
+ * @param y0 y-position in the complex-plane.
+ * @param from The state of the orbit to continue from: its iteration-count, position and derivative.
+ * @param nMax the maximum number of iterations.
+ * @param interiorCheck If the derivative of the orbit should be used to detect interior points early.
+ * @param epsilon An orbit returning this close to a saved point is considered periodic, from periodEpsilon.
+ * @param stats Iteration counters that are updated by the call.
+ * @return A struct containing the final iteration-count n, the position of the point and its derivative after n iterations and the estimated distance to the set (-1 if the point never escaped).
+ */
+brotStruct continueBrotDist(double x0, double y0, brotStruct from, int nMax, bool interiorCheck, double epsilon, mandelStats * stats)
 {
-    double i = 0;
-    double x = 0.0, y = 0.0, xTemp = -1.0, yTemp = -1.0;
-    double dx = 1.0, dy = 0.0, dxTemp = 0.0, dyTemp = 0.0;
+    int i = from.n, nextRef = from.n > 0 ? 2 * from.n : 1;
+    bool interior = false;
+    double x = from.x, y = from.y, xTemp = -1.0, yTemp = -1.0;
+    double xRef = x, yRef = y;
+    double dx = from.dx, dy = from.dy, dxTemp = 0.0;
+    double dzx = 1.0, dzy = 0.0, dzxTemp = 0.0;
+
+    brotStruct b;
+    b.dist = -1;
 
-    while(x*x + y*y < 10.0 && i < 300) {
+    while(x*x+y*y < 100.0 && i < nMax) {
         xTemp = x*x - y*y + x0;
         yTemp = 2.0*x*y + y0;
 
-        dxTemp = 2.0*x*dx - 2.0*y*dy + 1.0;
-        dyTemp = 2.0*x*dy + 2.0*y*dx;
+        dxTemp = 2.0*(x*dx - y*dy) + 1.0;
+        dy = 2.0*(x*dy + y*dx);
+        dx = dxTemp;
 
         x = xTemp;
         y = yTemp;
 
-        dx = dxTemp;
-        dy = dyTemp;
-
         i++;
+
+        if(fabs(x - xRef) + fabs(y - yRef) < epsilon) {
+            stats->periodSaved += nMax - i;
+            interior = true;
+            break;
+        }
+
+        if(i == nextRef) {
+            xRef = x;
+            yRef = y;
+            nextRef *= 2;
+        }
+
+        if(interiorCheck) {
+            dzxTemp = 2.0*(x*dzx - y*dzy);
+            dzy = 2.0*(x*dzy + y*dzx);
+            dzx = dzxTemp;
+
+            if(dzx*dzx + dzy*dzy < INTERIOR_EPSILON) {
+                stats->derivativeSaved += nMax - i;
+                interior = true;
+                break;
+            }
+        }
     }
 
-    double dist = 2.0 * sqrt(x*x+y*y)*log(sqrt(x*x+y*y))/sqrt(dx*dx+dy*dy);
+    stats->iterations += i - from.n;
+    if(interior) i = nMax;
+
+    b.n = i;
+    b.x = x;
+    b.y = y;
+    b.dx = dx;
+    b.dy = dy;
 
-    if(i >= 300) dist = -1;
+    if(i < nMax) {
+        double r = sqrt(x*x+y*y);
+        b.dist = 2.0 * r * log(r) / sqrt(dx*dx+dy*dy);
+    }
 
-    return dist;
+    return b;
 }
 
 /**
- * @brief Calculates the color of a single point.
- * @param fx x-position in the complex-plane.
- * @param fy y-position in the complex-plane.
- * @param m The struct containing the settings of the visualization.
- * @return 8-bit rgb color encoded in a 24-bit int.
+ * @brief Checks if a point is in the mandelbrot-set while tracking the derivative of the orbit, so that the escape-time and the distance-estimation is given by one single orbit.
+ * @param x0 x-position in the complex-plane.
+ * @param y0 y-position in the complex-plane.
+ * @param nMax the maximum number of iterations.
+ * @param interiorCheck If the derivative of the orbit should be used to detect interior points early.
+ * @param epsilon An orbit returning this close to a saved point is considered periodic, from periodEpsilon.
+ * @param stats Iteration counters that are updated by the call.
+ * @return A struct containing the final iteration-count n, the position of the point and its derivative after n iterations and the estimated distance to the set (-1 if the point never escaped).
  */
-unsigned int getColor(double fx, double fy, mandelData * m)
+brotStruct inBrotDist(double x0, double y0, int nMax, bool interiorCheck, double epsilon, mandelStats * stats)
 {
-    brotStruct bs = inBrot(fx, fy, m->iterations);
-
-    double f = log( log(sqrt(bs.x*bs.x+bs.y*bs.y)) / log(10))/log(2.0);
-    if(f!=f) {
-        f=0;
+    brotStruct b = {0, 0.0, 0.0, -1, 0.0, 0.0};
+
+    if(inCardioidOrBulb(x0, y0)) {
+        stats->cardioidSaved += nMax;
+        b.n = nMax;
+        b.x = x0;
+        b.y = y0;
+        return b;
     }
-    double v = (bs.n - f) / 1000.0;
 
-    unsigned int color = color_sample(m->c, v);
+    return continueBrotDist(x0, y0, b, nMax, interiorCheck, epsilon, stats);
+}
 
-    if(bs.n >= m->iterations) {
-        return 0 | (255 << 24);
+/**
+ * @brief Single precision version of inBrotDist that iterates a list of points, BROT_LANES at a time. The lanes are stepped together without branches so that the compiler can vectorize them, and a lane that is done is refilled with the next point of the list.
+ * @param x0 x-positions in the complex-plane.
+ * @param y0 y-positions in the complex-plane.
+ * @param count The number of points.
+ * @param nMax the maximum number of iterations.
+ * @param interiorCheck If the derivative of the orbit should be used to detect interior points early.
+ * @param epsilon An orbit returning this close to a saved point is considered periodic, from periodEpsilon.
+ * @param out count results, in the same order as the positions.
+ * @param from count orbits to continue from, as saved by an earlier call with a lower nMax, or NULL to start every orbit over. Periodicity detection starts over from the saved position, as in continueBrotDist.
+ * @param stats Iteration counters that are updated by the call.
+ */
+void inBrotListf(const float * x0, const float * y0, int count, int nMax, bool interiorCheck, float epsilon, brotStruct * out, const brotStruct * from, mandelStats * stats)
+{
+    float cx[BROT_LANES], cy[BROT_LANES], x[BROT_LANES], y[BROT_LANES], xRef[BROT_LANES], yRef[BROT_LANES];
+    float dx[BROT_LANES], dy[BROT_LANES], dzx[BROT_LANES], dzy[BROT_LANES];
+    int n[BROT_LANES], nextRef[BROT_LANES], active[BROT_LANES], periodic[BROT_LANES], attracted[BROT_LANES];
+    int point[BROT_LANES];
+    int next = 0;
+
+    for(int l = 0; l < BROT_LANES; l++) {
+        cx[l] = cy[l] = x[l] = y[l] = xRef[l] = yRef[l] = 0.0f;
+        dx[l] = dy[l] = dzx[l] = dzy[l] = 0.0f;
+        n[l] = nextRef[l] = active[l] = periodic[l] = attracted[l] = 0;
+        point[l] = -1;
     }
 
-    return color;
+    while(true) {
+        int alive = 0;
+
+        //collect the result of every finished lane and load the next point of the list into it
+        for(int l = 0; l < BROT_LANES; l++) {
+            if(active[l]) {
+                alive++;
+                continue;
+            }
+
+            if(point[l] >= 0) {
+                brotStruct * b = &out[point[l]];
+                b->n = n[l];
+                b->x = x[l];
+                b->y = y[l];
+                b->dx = dx[l];
+                b->dy = dy[l];
+                b->dist = -1;
+
+                stats->iterations += n[l] - (from ? from[point[l]].n : 0);
+                if(periodic[l]) stats->periodSaved += nMax - n[l];
+                else if(attracted[l]) stats->derivativeSaved += nMax - n[l];
+
+                if(periodic[l] || attracted[l]) {
+                    b->n = nMax;
+                } else if(n[l] < nMax) {
+                    double r = sqrt(b->x*b->x + b->y*b->y);
+                    b->dist = 2.0 * r * log(r) / sqrt((double)dx[l]*dx[l] + (double)dy[l]*dy[l]);
+                }
+
+                point[l] = -1;
+            }
+
+            while(next < count && point[l] < 0) {
+                int p = next++;
+
+                if(!from && inCardioidOrBulb(x0[p], y0[p])) {
+                    stats->cardioidSaved += nMax;
+                    out[p].n = nMax;
+                    out[p].x = x0[p];
+                    out[p].y = y0[p];
+                    out[p].dist = -1;
+                    continue;
+                }
+
+                point[l] = p;
+                cx[l] = x0[p];
+                cy[l] = y0[p];
+                x[l] = y[l] = xRef[l] = yRef[l] = 0.0f;
+                dx[l] = dy[l] = dzy[l] = 0.0f;
+                dzx[l] = 1.0f;
+                n[l] = periodic[l] = attracted[l] = 0;
+                nextRef[l] = 1;
+
+                if(from) {
+                    //the saved state was stored from these floats, so the orbit goes on exactly as if it had never stopped
+                    x[l] = xRef[l] = (float)from[p].x;
+                    y[l] = yRef[l] = (float)from[p].y;
+                    dx[l] = (float)from[p].dx;
+                    dy[l] = (float)from[p].dy;
+                    n[l] = from[p].n;
+                    nextRef[l] = n[l] > 0 ? 2 * n[l] : 1;
+                }
+
+                active[l] = n[l] < nMax;
+                alive += active[l];
+            }
+        }
+
+        if(alive == 0) break;
+
+        //a few steps between every refill, a finished lane is frozen until then
+        for(int step = 0; step < 8; step++) {
+            //the lanes are masked arithmetically, as gcc gives up vectorizing this many selects on the same condition
+            for(int l = 0; l < BROT_LANES; l++) {
+                int a = active[l];
+                float af = (float)a;
+                float xn = x[l]*x[l] - y[l]*y[l] + cx[l];
+                float yn = 2.0f*x[l]*y[l] + cy[l];
+                float dxn = 2.0f*(x[l]*dx[l] - y[l]*dy[l]) + 1.0f;
+                float dyn = 2.0f*(x[l]*dy[l] + y[l]*dx[l]);
+
+                x[l] += af*(xn - x[l]);
+                y[l] += af*(yn - y[l]);
+                dx[l] += af*(dxn - dx[l]);
+                dy[l] += af*(dyn - dy[l]);
+                n[l] += a;
+
+                int isPeriodic = a & (fabsf(xn - xRef[l]) + fabsf(yn - yRef[l]) < epsilon);
+                int atRef = a & (n[l] == nextRef[l]);
+                xRef[l] += (float)atRef*(xn - xRef[l]);
+                yRef[l] += (float)atRef*(yn - yRef[l]);
+                nextRef[l] += atRef*nextRef[l];
+
+                periodic[l] |= isPeriodic;
+                active[l] = a & (xn*xn + yn*yn < 100.0f) & (n[l] < nMax) & !isPeriodic;
+            }
+
+            if(interiorCheck) {
+                for(int l = 0; l < BROT_LANES; l++) {
+                    int a = active[l];
+                    float dzxn = 2.0f*(x[l]*dzx[l] - y[l]*dzy[l]);
+                    float dzyn = 2.0f*(x[l]*dzy[l] + y[l]*dzx[l]);
+
+                    dzx[l] += (float)a*(dzxn - dzx[l]);
+                    dzy[l] += (float)a*(dzyn - dzy[l]);
+
+                    int isAttracted = a & (dzxn*dzxn + dzyn*dzyn < (float)INTERIOR_EPSILON);
+                    attracted[l] |= isAttracted;
+                    active[l] = a & !isAttracted;
+                }
+            }
+        }
+    }
 }
 
 /**
- * @brief Calculates the color of a point in the set with anti-aliasing.
- * @param fx x-position in the complex-plane.
- * @param fy y-position in the complex-plane.
+ * @brief Darkens a color by the distance of a point to the set, so that the boundary is drawn as a line about a pixel wide, smoothed as if anti-aliased.
+ * @param color The color of the point.
+ * @param dist The estimated distance to the set.
  * @param m The struct containing the settings of the visualization.
- * @param pixelSize The size of a pixel give in complex-plane coordinates.
- * @param pixelDivids Anti-aliasing level. 0 means just 1 sample per pixel, 1 means 9 samples per pixel, 2 means 25 samples per pixel.
  * @return 8-bit rgb color encoded in a 24-bit int.
  */
-unsigned int colorPixel(double fx, double fy, mandelData * m, double pixelSize, int pixelDivids)
+unsigned int shadeDistance(unsigned int color, double dist, mandelData * m)
 {
-    int numSamples = (pixelDivids * 2 + 1);
-    numSamples *= numSamples;
+    //the formula kernels do not estimate the distance, it is -1 for them
+    if(dist < 0.0) return color;
 
-    unsigned int samples[numSamples];
-    int sampleAt = 0;
+    double f = dist / (fabs(m->location.w) / (double)m->width * DISTANCE_SHADE_PIXELS);
+    if(f != f || f > 1.0) return color;
 
-    bool shouldBreak = false;
+    unsigned int red = (unsigned int)(f * (double)((color >> 0) & 255));
+    unsigned int green = (unsigned int)(f * (double)((color >> 8) & 255));
+    unsigned int blue = (unsigned int)(f * (double)((color >> 16) & 255));
 
-    unsigned int c;
-
-    for(int x = -pixelDivids; x <= pixelDivids; x++) {
-        for(int y = -pixelDivids; y <= pixelDivids; y++) {
-            if(shouldBreak) c = 0;
-            else c = getColor(fx + pixelSize/(double)(pixelDivids * 2 + 1) * (double)x, fy + pixelSize/(double)(pixelDivids * 2 + 1) * (double)y, m);
+    return red | (green << 8) | (blue << 16) | (255 << 24);
+}
 
-            if(c == (0U | (255 << 24))) shouldBreak = true; // 0U to fix warning for comparison between signed and unsigned
+/**
+ * @brief Calculates the color of a point that has already been iterated.
+ * @param bs The result of iterating the point.
+ * @param m The struct containing the settings of the visualization.
+ * @return 8-bit rgb color encoded in a 24-bit int.
+ */
+unsigned int colorBrot(brotStruct bs, mandelData * m)
+{
+    if(bs.n >= m->iterations) {
+        return 0 | (255 << 24);
+    }
 
-            samples[sampleAt] = c;
-            sampleAt++;
-        }
+    double f = log( log(sqrt(bs.x*bs.x+bs.y*bs.y)) / log(10))/log((double)m->power);
+    if(f!=f) {
+        f=0;
     }
+    double v = (bs.n - f) / 1000.0;
 
-    return color_blend(samples, numSamples);
+    if(m->renderMode == MANDEL_RENDER_DISTANCE) return shadeDistance(color_sample(m->c, v), bs.dist, m);
+
+    return color_sample(m->c, v);
 }
 
 /**
- * @brief Calculates every pixel in a rectangle.
- * @param calcLocation A rectangle in the complex-plane that is to be calculated.
- * @param m Settings for the visualization.
+ * @brief Iterates a list of points in single precision with inBrotListf.
+ * @param m The settings of the visualization.
+ * @param ox x-positions given as offsets from the upper left corner of the visualization.
+ * @param oy y-positions given as offsets from the upper left corner of the visualization.
+ * @param count The number of points.
+ * @param interiorCheck If the derivative of the orbits should be used to detect interior points early, where the kernel supports it.
+ * @param out count results, in the same order as the positions.
+ * @param stats Iteration counters of the calling job.
  */
-void calculateRectangle(rectangle calcLocation, mandelData * m)   //added m-> to location.w & h
+void listKernelf(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats)
 {
-    //the rectangle calcLocation is located in the complex-plane
-    //the size and location of this rectangle must be translated into screen-coordinates
-    int xScreen = (int)((calcLocation.x - m->location.x)/m->location.w * (double) m->width);
-    int yScreen = (int)((calcLocation.y - m->location.y)/m->location.h * (double) m->height);
-    int rectScreenWidth = (int)(calcLocation.w/m->location.w*(double)m->width);
-    int rectScreenHeight = (int)(calcLocation.h/m->location.h*(double)m->height);
+    float * cx = (float*) malloc(sizeof(float) * count);
+    float * cy = (float*) malloc(sizeof(float) * count);
+
+    for(int a = 0; a < count; a++) {
+        cx[a] = (float)(m->location.x + ox[a]);
+        cy[a] = (float)(m->location.y + oy[a]);
+    }
+
+    inBrotListf(cx, cy, count, m->iterations, interiorCheck, (float)periodEpsilon(m, PERIOD_EPSILON_F), out, NULL, stats);
+
+    free(cx);
+    free(cy);
+}
 
-    //a size of a screenpixel given i complex-plane coordinates
-    double pixelSize = calcLocation.w/(double)rectScreenWidth;
+/**
+ * @brief Iterates a list of points in double-double precision with dd_inBrotList. The offsets are added to the corner of the visualization in double-double, so the points are exact even when a pixel is smaller than an ulp of the corner.
+ * @param m The settings of the visualization.
+ * @param ox x-positions given as offsets from the upper left corner of the visualization.
+ * @param oy y-positions given as offsets from the upper left corner of the visualization.
+ * @param count The number of points.
+ * @param interiorCheck If the derivative of the orbits should be used to detect interior points early, where the kernel supports it.
+ * @param out count results, in the same order as the positions.
+ * @param stats Iteration counters of the calling job.
+ */
+void listKerneldd(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats)
+{
+    doubleDouble * cx = (doubleDouble*) calloc(count, sizeof(doubleDouble));
+    doubleDouble * cy = (doubleDouble*) calloc(count, sizeof(doubleDouble));
+    ddResult * results = (ddResult*) malloc(sizeof(ddResult) * count);
+    int * index = (int*) malloc(sizeof(int) * count);
+    int numPoints = 0;
+    (void)interiorCheck; //dd_inBrotList relies on periodicity detection only
+
+    //points in the main cardioid or the period-2 bulb are left out of the list
+    for(int a = 0; a < count; a++) {
+        doubleDouble x = dd_add(m->originX, dd_fromDouble(ox[a]));
+        doubleDouble y = dd_add(m->originY, dd_fromDouble(oy[a]));
+
+        if(inCardioidOrBulb(x.hi, y.hi)) {
+            stats->cardioidSaved += m->iterations;
+            out[a].n = m->iterations;
+            out[a].x = x.hi;
+            out[a].y = y.hi;
+            out[a].dist = -1;
+            continue;
+        }
 
-    //zoom-estimation for scaling of the distance-estimation to the mandelbrot-set
-    double zoomEst = 1.0/(m->location.w/2.0);
+        cx[numPoints] = x;
+        cy[numPoints] = y;
+        index[numPoints] = a;
+        numPoints++;
+    }
 
-    //when calcLocation has been mapped to screen-coordinates, each of the pixels in calcLocation is calculated
-    for(int x = xScreen; x <= xScreen + rectScreenWidth; x++) {
-        for(int y = yScreen; y <= yScreen + rectScreenHeight; y++) {
-	    //a hack used to solve a problem causes some pixels to be outside the image
-            if(x >= m-> width || y >= m-> height) continue;
+    dd_inBrotList(cx, cy, numPoints, m->iterations, periodEpsilon(m, PERIOD_EPSILON), results);
 
-            //translate from screen-coordinates to coodrinates in the complex-plane
-            double fx = calcLocation.x + (double)(x - xScreen)/(double)rectScreenWidth*calcLocation.w;
-            double fy = calcLocation.y + (double)(y - yScreen)/(double)rectScreenHeight*calcLocation.h;
+    for(int a = 0; a < numPoints; a++) {
+        brotStruct * b = &out[index[a]];
+        b->n = results[a].n;
+        b->x = results[a].x;
+        b->y = results[a].y;
+        b->dist = -1;
 
-            double dist = mandelDist(fx, fy);
+        stats->iterations += results[a].n;
 
-	    //if a pixel is to far away from the mandelbrot-set it does not need antialiasing
-            if(dist > 0.05/zoomEst) m->image[y * m->width + x] = colorPixel(fx, fy, m, pixelSize, 0);
-            else m->image[y * m->width + x] = colorPixel(fx, fy, m, pixelSize, 1);
+        if(results[a].periodic) {
+            stats->periodSaved += m->iterations - results[a].n;
+            b->n = m->iterations;
+        } else if(b->n < m->iterations) {
+            double r = sqrt(b->x*b->x + b->y*b->y);
+            b->dist = 2.0 * r * log(r) / sqrt(results[a].dx*results[a].dx + results[a].dy*results[a].dy);
         }
     }
+
+    free(cx);
+    free(cy);
+    free(results);
+    free(index);
 }
 
 /**
- * @brief The function called by the threadpool. Decodes the void pointer.
- * @param arg The arguments supplied by the user when the job was created.
+ * @brief Calculates a reference orbit, in double-double or in fixed-point when the view is too deep for double-double.
+ * @param m The settings of the visualization.
+ * @param ox x-position of the reference, given as an offset from the upper left corner of the visualization.
+ * @param oy y-position of the reference, given as an offset from the upper left corner of the visualization.
+ * @return A refOrbit struct.
  */
-void mandelJob(void * arg)
+refOrbit * createReference(mandelData * m, double ox, double oy)
 {
-    mandelJobArg * jobArg = (mandelJobArg*) arg;
-    calculateRectangle(jobArg->calcLocation, jobArg->data);
-    free(jobArg);
+    if(m->fixedBits == 0) {
+        return perturb_createOrbit(dd_add(m->originX, dd_fromDouble(ox)), dd_add(m->originY, dd_fromDouble(oy)), m->iterations);
+    }
+
+    //the exact position is only kept for the center
+    fixedNumber x = fixed_add(m->centerX, fixed_fromDouble(ox - m->location.w / 2.0));
+    fixedNumber y = fixed_add(m->centerY, fixed_fromDouble(oy - m->location.h / 2.0));
+    return perturb_createOrbitFixed(m->fixedBits, &x, &y, m->iterations);
 }
 
 /**
- * @brief The function called by the thread created by mandel_renderUnifinished.
- * @param arg a threadArgs struct cast as a void pointer.
+ * @brief Iterates a list of points directly in fixed-point with fixed_inBrot. It is much slower than perturbation, but does not depend on a reference.
+ * @param m The settings of the visualization.
+ * @param ox x-positions given as offsets from the upper left corner of the visualization.
+ * @param oy y-positions given as offsets from the upper left corner of the visualization.
+ * @param count The number of points.
+ * @param interiorCheck If the derivative of the orbits should be used to detect interior points early, where the kernel supports it.
+ * @param out count results, in the same order as the positions.
+ * @param stats Iteration counters of the calling job.
  */
-void * threadFunc(void * arg)
+void listKernelFixed(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats)
 {
-    struct threadArgs * t = (struct threadArgs *)arg;
-    mandel_render(t->m, t->numthreads, t->split);
-    free(t);
-    pthread_exit(NULL);
-    return NULL;
-}
+    (void)interiorCheck; //fixed_inBrot has no interior detection
+    for(int a = 0; a < count; a++) {
+        brotStruct * b = &out[a];
+        b->n = m->iterations;
+        b->x = m->location.x + ox[a];
+        b->y = m->location.y + oy[a];
+        b->dist = -1;
+
+        if(inCardioidOrBulb(b->x, b->y)) {
+            stats->cardioidSaved += m->iterations;
+            continue;
+        }
 
+        fixedNumber x = fixed_add(m->centerX, fixed_fromDouble(ox[a] - m->location.w / 2.0));
+        fixedNumber y = fixed_add(m->centerY, fixed_fromDouble(oy[a] - m->location.h / 2.0));
+        fixedResult r = fixed_inBrot(m->fixedBits, &x, &y, m->iterations);
 
-// ---public functions---
+        stats->iterations += r.n;
+        b->n = r.n;
+        b->x = r.x;
+        b->y = r.y;
 
-mandelData * mandel_createMandelData(int iterations, double xFrom, double yFrom, double xTo, double yTo, int imageWidth, int imageHeight, colorPalette * c)
-{
-    mandelData * m = (mandelData*) malloc(sizeof(mandelData));
-    m->iterations = iterations;
+        if(r.n < m->iterations) {
+            double radius = sqrt(r.x*r.x + r.y*r.y);
+            b->dist = 2.0 * radius * log(radius) / sqrt(r.dx*r.dx + r.dy*r.dy);
+        }
+    }
+}
 
-    rectangle location;
-    location.x = xFrom;
-    location.y = yFrom;
-    location.w = xTo - xFrom;
-    location.h = yTo - yFrom;
+/**
+ * @brief Iterates a list of points as double precision offsets from the reference orbit of the visualization. Glitched points are iterated again against a new reference, calculated for one of them, and the points that are still glitched after PERTURB_MAX_REFERENCES references are iterated directly with listKerneldd or listKernelFixed.
+ * @param m The settings of the visualization.
+ * @param ox x-positions given as offsets from the upper left corner of the visualization.
+ * @param oy y-positions given as offsets from the upper left corner of the visualization.
+ * @param count The number of points.
+ * @param interiorCheck If the derivative of the orbits should be used to detect interior points early, where the kernel supports it.
+ * @param out count results, in the same order as the positions.
+ * @param stats Iteration counters of the calling job.
+ */
+void listKernelp(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats)
+{
+    double * dcx = (double*) calloc(count, sizeof(double));
+    double * dcy = (double*) calloc(count, sizeof(double));
+    double * gx = (double*) calloc(count, sizeof(double));
+    double * gy = (double*) calloc(count, sizeof(double));
+    perturbResult * results = (perturbResult*) malloc(sizeof(perturbResult) * count);
+    perturbResult * glitchResults = (perturbResult*) malloc(sizeof(perturbResult) * count);
+    int * index = (int*) malloc(sizeof(int) * count);
+    int * glitched = (int*) malloc(sizeof(int) * count);
+    int numPoints = 0, numGlitched = 0;
+
+    //the reference of the visualization is its center
+    double refX = m->location.w / 2.0, refY = m->location.h / 2.0;
+
+    //the series approximation may skip iterations as long as its error stays well below a pixel
+    double tolerance = fabs(m->location.w) / (double)m->width * SERIES_TOLERANCE;
+
+    for(int a = 0; a < count; a++) {
+        if(inCardioidOrBulb(m->location.x + ox[a], m->location.y + oy[a])) {
+            stats->cardioidSaved += m->iterations;
+            out[a].n = m->iterations;
+            out[a].x = m->location.x + ox[a];
+            out[a].y = m->location.y + oy[a];
+            out[a].dist = -1;
+            continue;
+        }
+
+        dcx[numPoints] = ox[a] - refX;
+        dcy[numPoints] = oy[a] - refY;
+        index[numPoints] = a;
+        numPoints++;
+    }
+
+    int skip = m->seriesApproximation ? perturb_seriesSkip(m->reference, dcx, dcy, numPoints, m->iterations, tolerance) : 0;
+    perturb_inBrotList(m->reference, dcx, dcy, numPoints, m->iterations, skip, interiorCheck, results);
+
+    for(int pass = 0; pass <= PERTURB_MAX_REFERENCES; pass++) {
+        numGlitched = 0;
+        for(int a = 0; a < numPoints; a++) {
+            if(results[a].glitched) glitched[numGlitched++] = a;
+        }
+
+        if(numGlitched == 0 || pass == PERTURB_MAX_REFERENCES) break;
+
+        //a glitched point is used as the new reference, so at least that point is correct after this pass
+        int pick = glitched[numGlitched / 2];
+        refOrbit * r = createReference(m, refX + dcx[pick], refY + dcy[pick]);
+        stats->references++;
+
+        for(int g = 0; g < numGlitched; g++) {
+            gx[g] = dcx[glitched[g]] - dcx[pick];
+            gy[g] = dcy[glitched[g]] - dcy[pick];
+        }
+        skip = m->seriesApproximation ? perturb_seriesSkip(r, gx, gy, numGlitched, m->iterations, tolerance) : 0;
+        perturb_inBrotList(r, gx, gy, numGlitched, m->iterations, skip, interiorCheck, glitchResults);
+
+        for(int g = 0; g < numGlitched; g++) {
+            stats->iterations += results[glitched[g]].n - results[glitched[g]].skipped;
+            stats->seriesSkipped += results[glitched[g]].skipped;
+            results[glitched[g]] = glitchResults[g];
+        }
+
+        perturb_destroyOrbit(r);
+    }
+
+    for(int a = 0; a < numPoints; a++) {
+        if(results[a].glitched) continue;
+
+        brotStruct * b = &out[index[a]];
+        b->n = results[a].n;
+        b->x = results[a].x;
+        b->y = results[a].y;
+        b->dist = -1;
+
+        stats->iterations += results[a].n - results[a].skipped;
+        stats->seriesSkipped += results[a].skipped;
+
+        if(results[a].interior) {
+            stats->derivativeSaved += m->iterations - results[a].n;
+            b->n = m->iterations;
+        } else if(b->n < m->iterations) {
+            double r = sqrt(b->x*b->x + b->y*b->y);
+            b->dist = 2.0 * r * log(r) / sqrt(results[a].dx*results[a].dx + results[a].dy*results[a].dy);
+        }
+    }
+
+    //what no reference could fix is iterated directly
+    if(numGlitched > 0) {
+        listKernel direct = m->fixedBits == 0 ? listKerneldd : listKernelFixed;
+        brotStruct * fallback = (brotStruct*) malloc(sizeof(brotStruct) * numGlitched);
+
+        for(int g = 0; g < numGlitched; g++) {
+            stats->iterations += results[glitched[g]].n - results[glitched[g]].skipped;
+            stats->seriesSkipped += results[glitched[g]].skipped;
+            gx[g] = ox[index[glitched[g]]];
+            gy[g] = oy[index[glitched[g]]];
+        }
+        direct(m, gx, gy, numGlitched, interiorCheck, fallback, stats);
+
+        for(int g = 0; g < numGlitched; g++) out[index[glitched[g]]] = fallback[g];
+
+        free(fallback);
+    }
+
+    free(dcx);
+    free(dcy);
+    free(gx);
+    free(gy);
+    free(results);
+    free(glitchResults);
+    free(index);
+    free(glitched);
+}
+
+/**
+ * @brief Iterates a list of points in double precision with inBrot, or with inBrotDist when the distance-estimation is rendered.
+ * @param m The settings of the visualization.
+ * @param ox x-positions given as offsets from the upper left corner of the visualization.
+ * @param oy y-positions given as offsets from the upper left corner of the visualization.
+ * @param count The number of points.
+ * @param interiorCheck If the derivative of the orbits should be used to detect interior points early, where the kernel supports it.
+ * @param out count results, in the same order as the positions.
+ * @param stats Iteration counters of the calling job.
+ */
+void listKerneld(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats)
+{
+    double epsilon = periodEpsilon(m, PERIOD_EPSILON);
+
+    if(m->renderMode == MANDEL_RENDER_DISTANCE) {
+        for(int a = 0; a < count; a++) {
+            out[a] = inBrotDist(m->location.x + ox[a], m->location.y + oy[a], m->iterations, interiorCheck, epsilon, stats);
+        }
+        return;
+    }
+
+    for(int a = 0; a < count; a++) {
+        out[a] = inBrot(m->location.x + ox[a], m->location.y + oy[a], m->iterations, interiorCheck, epsilon, stats);
+    }
+}
+
+//the steps of the formula kernels, z^POWER for z = x + iy
+#define POWER_2(x, y, xn, yn) { xn = x*x - y*y; yn = 2.0*x*y; }
+#define POWER_3(x, y, xn, yn) { double x2 = x*x, y2 = y*y; xn = x*(x2 - 3.0*y2); yn = y*(3.0*x2 - y2); }
+#define POWER_4(x, y, xn, yn) { double re = x*x - y*y, im = 2.0*x*y; xn = re*re - im*im; yn = 2.0*re*im; }
+
+//the folds applied to z before the power, the burning ship takes the absolute values of both parts
+#define FOLD_NONE(x, y)
+#define FOLD_ABS(x, y) { x = fabs(x); y = fabs(y); }
+
+/**
+ * @brief Instantiates a formula kernel, a list kernel in double precision for one formula and power. Each instantiation gets its own copy of the loop where the formula is fixed at compile time, so that it has no branches on the settings and its lanes can be vectorized like inBrotListf. The points are iterated BROT_LANES at a time, with periodicity detection but without the cardioid test or the distance-estimation, which only hold for the mandelbrot-set itself.
+ * @param NAME The name of the kernel.
+ * @param JULIA 1 if the point is the start of the orbit and the seed of the visualization is added, 0 if the orbit starts at 0 and the point is added.
+ * @param FOLD FOLD_NONE or FOLD_ABS.
+ * @param POWER POWER_2, POWER_3 or POWER_4.
+ * @param RADIUS2 The escape radius, squared.
+ */
+#define FORMULA_KERNEL(NAME, JULIA, FOLD, POWER, RADIUS2) \
+void NAME(mandelData * m, const double * ox, const double * oy, int count, bool interiorCheck, brotStruct * out, mandelStats * stats) \
+{ \
+    int nMax = m->iterations; \
+    double epsilon = periodEpsilon(m, PERIOD_EPSILON); \
+    (void)interiorCheck; /* the derivative test only holds for the mandelbrot-set itself */ \
+ \
+    for(int first = 0; first < count; first += BROT_LANES) { \
+        double x[BROT_LANES], y[BROT_LANES], cx[BROT_LANES], cy[BROT_LANES], xRef[BROT_LANES], yRef[BROT_LANES]; \
+        int n[BROT_LANES], nextRef[BROT_LANES], active[BROT_LANES], periodic[BROT_LANES]; \
+        int lanes = count - first < BROT_LANES ? count - first : BROT_LANES; \
+ \
+        /* lanes past the end of the list are started on its last point and never stepped */ \
+        for(int l = 0; l < BROT_LANES; l++) { \
+            int p = first + (l < lanes ? l : lanes - 1); \
+            double px = m->location.x + ox[p], py = m->location.y + oy[p]; \
+            x[l] = JULIA ? px : 0.0; \
+            y[l] = JULIA ? py : 0.0; \
+            cx[l] = JULIA ? m->juliaX : px; \
+            cy[l] = JULIA ? m->juliaY : py; \
+            xRef[l] = x[l]; \
+            yRef[l] = y[l]; \
+            n[l] = periodic[l] = 0; \
+            nextRef[l] = 1; \
+            active[l] = l < lanes && nMax > 0; \
+        } \
+ \
+        for(;;) { \
+            int alive = 0; \
+            for(int l = 0; l < BROT_LANES; l++) alive |= active[l]; \
+            if(!alive) break; \
+ \
+            for(int step = 0; step < 8; step++) { \
+                for(int l = 0; l < BROT_LANES; l++) { \
+                    int a = active[l]; \
+                    double af = (double)a; \
+                    double fx = x[l], fy = y[l], xn, yn; \
+                    FOLD(fx, fy) \
+                    POWER(fx, fy, xn, yn) \
+                    xn += cx[l]; \
+                    yn += cy[l]; \
+ \
+                    x[l] += af*(xn - x[l]); \
+                    y[l] += af*(yn - y[l]); \
+                    n[l] += a; \
+ \
+                    int isPeriodic = a & (fabs(xn - xRef[l]) + fabs(yn - yRef[l]) < epsilon); \
+                    int atRef = a & (n[l] == nextRef[l]); \
+                    xRef[l] += (double)atRef*(xn - xRef[l]); \
+                    yRef[l] += (double)atRef*(yn - yRef[l]); \
+                    nextRef[l] += atRef*nextRef[l]; \
+ \
+                    periodic[l] |= isPeriodic; \
+                    active[l] = a & (xn*xn + yn*yn < RADIUS2) & (n[l] < nMax) & !isPeriodic; \
+                } \
+            } \
+        } \
+ \
+        for(int l = 0; l < lanes; l++) { \
+            brotStruct * b = &out[first + l]; \
+            stats->iterations += n[l]; \
+            if(periodic[l]) stats->periodSaved += nMax - n[l]; \
+ \
+            b->n = periodic[l] ? nMax : n[l]; \
+            b->x = x[l]; \
+            b->y = y[l]; \
+            b->dist = -1; \
+            b->dx = 0.0; \
+            b->dy = 0.0; \
+        } \
+    } \
+}
+
+FORMULA_KERNEL(listKernelMandelbrot3, 0, FOLD_NONE, POWER_3, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelMandelbrot4, 0, FOLD_NONE, POWER_4, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelJulia2, 1, FOLD_NONE, POWER_2, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelJulia3, 1, FOLD_NONE, POWER_3, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelJulia4, 1, FOLD_NONE, POWER_4, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelShip2, 0, FOLD_ABS, POWER_2, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelShip3, 0, FOLD_ABS, POWER_3, FORMULA_ESCAPE_RADIUS2)
+FORMULA_KERNEL(listKernelShip4, 0, FOLD_ABS, POWER_4, FORMULA_ESCAPE_RADIUS2)
+
+/**
+ * @brief The formula kernels, by formula and power - 2. The mandelbrot-set with power 2 has no entry, it uses the kernels of the precisions instead.
+ */
+static const listKernel formulaKernels[3][MANDEL_MAX_POWER - 1] = {
+    {NULL, listKernelMandelbrot3, listKernelMandelbrot4},
+    {listKernelJulia2, listKernelJulia3, listKernelJulia4},
+    {listKernelShip2, listKernelShip3, listKernelShip4}
+};
+
+/**
+ * @brief Checks if a visualization is of the mandelbrot-set itself, which is what the cardioid test, the distance-estimation, perturbation and resuming are made for.
+ * @param m The settings of the visualization.
+ * @return true if the formula is the mandelbrot-set with power 2.
+ */
+bool isStandardFormula(mandelData * m)
+{
+    return m->formula == MANDEL_FORMULA_MANDELBROT && m->power == 2;
+}
+
+/**
+ * @brief Checks if a render of a visualization can be continued to a higher iteration cap by resumeRender. Only the float and double kernels give orbits that can be continued. Rectangle checking gives the filled pixels the orbit of a corner, and whether a part is filled depends on the cap, so those renders are started over.
+ * @param m The settings of the visualization, prepared for the render.
+ * @return true if the pixels that reach the cap should be saved.
+ */
+bool canResume(mandelData * m)
+{
+    return m->precision <= MANDEL_PRECISION_DOUBLE && isStandardFormula(m) && !m->rectangleChecking;
+}
+
+/**
+ * @brief Colors the pixels of a rectangle from the results of their centers, and saves their iteration-counts for the anti-aliasing pass.
+ * @param t The rectangle, with the results of all its pixels.
+ */
+void colorTile(tileData * t)
+{
+    mandelData * m = t->m;
+
+    for(int r = 0; r < t->rows; r++) {
+        //a row of the rectangle is one run of memory, or one run per block in the tiled layout
+        for(int c = 0; c < t->columns;) {
+            int run = pixelRun(m, t->xScreen + c, t->columns - c);
+            unsigned int * image = &m->image[pixelOffset(m, t->xScreen + c, t->yScreen + r)];
+            int * counts = &m->counts[pixelOffset(m, t->xScreen + c, t->yScreen + r)];
+            const brotStruct * cells = &t->cells[cellIndex(t, c, r)];
+
+            for(int a = 0; a < run; a++) {
+                image[a] = colorBrot(cells[a], m);
+                counts[a] = cells[a].n;
+            }
+            c += run;
+        }
+    }
+}
+
+/**
+ * @brief The pixel loop of calculateRectangle for the list kernels. Each column is iterated as one list, and then colored by colorTile.
+ * @param t The rectangle, its cells are set to the results of its pixels.
+ */
+void calculateRectangleList(tileData * t)
+{
+    double * ox = (double*) malloc(sizeof(double) * t->columns);
+    double * oy = (double*) malloc(sizeof(double) * t->columns);
+
+    for(int r = 0; r < t->rows; r++) {
+        for(int c = 0; c < t->columns; c++) {
+            ox[c] = tileX(t, c);
+            oy[c] = tileY(t, r);
+        }
+        t->kernel(t->m, ox, oy, t->columns, t->m->interiorDetection, &t->cells[cellIndex(t, 0, r)], t->stats);
+    }
+
+    colorTile(t);
+
+    free(ox);
+    free(oy);
+}
+
+/**
+ * @brief Iterates the pixels of a part of a rectangle that have not been iterated yet, as one list.
+ * @param t The rectangle.
+ * @param state The state of every cell, set to CELL_ITERATED for the iterated ones.
+ * @param c0 The first column.
+ * @param r0 The first row.
+ * @param c1 The last column.
+ * @param r1 The last row.
+ * @param borderOnly If only the border of the part should be iterated.
+ */
+void iterateCells(tileData * t, char * state, int c0, int r0, int c1, int r1, bool borderOnly)
+{
+    int count = 0;
+    int maxCount = (c1 - c0 + 1) * (r1 - r0 + 1);
+    double * ox = (double*) malloc(sizeof(double) * maxCount);
+    double * oy = (double*) malloc(sizeof(double) * maxCount);
+    int * index = (int*) malloc(sizeof(int) * maxCount);
+    brotStruct * results = (brotStruct*) malloc(sizeof(brotStruct) * maxCount);
+
+    for(int r = r0; r <= r1; r++) {
+        for(int c = c0; c <= c1; c++) {
+            bool border = c == c0 || c == c1 || r == r0 || r == r1;
+            if(borderOnly && !border) continue;
+            if(state[cellIndex(t, c, r)] != CELL_EMPTY) continue;
+
+            ox[count] = tileX(t, c);
+            oy[count] = tileY(t, r);
+            index[count] = cellIndex(t, c, r);
+            count++;
+        }
+    }
+
+    if(count > 0) t->kernel(t->m, ox, oy, count, t->m->interiorDetection, results, t->stats);
+
+    for(int a = 0; a < count; a++) {
+        t->cells[index[a]] = results[a];
+        state[index[a]] = CELL_ITERATED;
+    }
+
+    free(ox);
+    free(oy);
+    free(index);
+    free(results);
+}
+
+/**
+ * @brief Fills a pixel inside a part of a rectangle whose border has one iteration-count. The pixel gets that count, and the parts of the result that the smooth coloring and the distance-estimation read are interpolated bilinearly from the corners of the part: the logarithm of the final radius, and the distance if every corner has one. The result is an approximation of iterating the pixel, the colors of a filled part are smooth but not exactly the ones of a full render.
+ * @param t The rectangle.
+ * @param c The column of the pixel.
+ * @param r The row of the pixel.
+ * @param c0 The first column of the part.
+ * @param r0 The first row of the part.
+ * @param c1 The last column of the part.
+ * @param r1 The last row of the part.
+ */
+void fillCell(tileData * t, int c, int r, int c0, int r0, int c1, int r1)
+{
+    const brotStruct * corner[4] = {
+        &t->cells[cellIndex(t, c0, r0)], &t->cells[cellIndex(t, c1, r0)],
+        &t->cells[cellIndex(t, c0, r1)], &t->cells[cellIndex(t, c1, r1)]
+    };
+    double u = (double)(c - c0) / (double)(c1 - c0);
+    double v = (double)(r - r0) / (double)(r1 - r0);
+    double weight[4] = {(1.0 - u) * (1.0 - v), u * (1.0 - v), (1.0 - u) * v, u * v};
+    brotStruct * b = &t->cells[cellIndex(t, c, r)];
+
+    *b = *corner[0];
+
+    //interior points are black whatever their radius
+    if(b->n >= t->m->iterations) return;
+
+    double logRadius = 0.0, dist = 0.0;
+    bool hasDist = true;
+    for(int k = 0; k < 4; k++) {
+        logRadius += weight[k] * 0.5 * log(corner[k]->x * corner[k]->x + corner[k]->y * corner[k]->y);
+        dist += weight[k] * corner[k]->dist;
+        hasDist = hasDist && corner[k]->dist >= 0.0;
+    }
+
+    b->x = exp(logRadius);
+    b->y = 0.0;
+    b->dist = hasDist ? dist : -1;
+}
+
+/**
+ * @brief Mariani-Silver rectangle checking. The border of a part of the rectangle is iterated, and if every pixel on it has the same iteration-count the inside is filled with it by fillCell. Since the mandelbrot-set is connected, nothing inside can have another count (at the resolution of the pixels). Otherwise the part is split into four parts that share their borders.
+ * @param t The rectangle.
+ * @param state The state of every cell.
+ * @param c0 The first column.
+ * @param r0 The first row.
+ * @param c1 The last column.
+ * @param r1 The last row.
+ */
+void checkRectangle(tileData * t, char * state, int c0, int r0, int c1, int r1)
+{
+    //small parts are cheaper to iterate than to check
+    if(c1 - c0 < RECTANGLE_MIN_SIZE || r1 - r0 < RECTANGLE_MIN_SIZE) {
+        iterateCells(t, state, c0, r0, c1, r1, false);
+        return;
+    }
+
+    iterateCells(t, state, c0, r0, c1, r1, true);
+
+    int n = t->cells[cellIndex(t, c0, r0)].n;
+    bool uniform = true;
+    for(int c = c0; c <= c1 && uniform; c++) {
+        uniform = t->cells[cellIndex(t, c, r0)].n == n && t->cells[cellIndex(t, c, r1)].n == n;
+    }
+    for(int r = r0; r <= r1 && uniform; r++) {
+        uniform = t->cells[cellIndex(t, c0, r)].n == n && t->cells[cellIndex(t, c1, r)].n == n;
+    }
+
+    if(uniform) {
+        for(int r = r0 + 1; r < r1; r++) {
+            for(int c = c0 + 1; c < c1; c++) {
+                if(state[cellIndex(t, c, r)] != CELL_EMPTY) continue;
+                fillCell(t, c, r, c0, r0, c1, r1);
+                state[cellIndex(t, c, r)] = CELL_FILLED;
+                t->stats->filledPixels++;
+            }
+        }
+        return;
+    }
+
+    int cm = (c0 + c1) / 2, rm = (r0 + r1) / 2;
+    checkRectangle(t, state, c0, r0, cm, rm);
+    checkRectangle(t, state, cm, r0, c1, rm);
+    checkRectangle(t, state, c0, rm, cm, r1);
+    checkRectangle(t, state, cm, rm, c1, r1);
+}
+
+/**
+ * @brief The pixel loop of calculateRectangle with rectangle checking. The pixels are found by checkRectangle and then colored by colorTile.
+ * @param t The rectangle, its cells are set to the results of its pixels.
+ */
+void calculateRectangleChecked(tileData * t)
+{
+    char * state = (char*) calloc(t->columns * t->rows, sizeof(char));
+
+    checkRectangle(t, state, 0, 0, t->columns - 1, t->rows - 1);
+    colorTile(t);
+
+    free(state);
+}
+
+/**
+ * @brief Adds the counters of a finished job to the statistics of the render.
+ * @param m The settings of the visualization.
+ * @param stats The counters of the job.
+ */
+void addStats(mandelData * m, const mandelStats * stats)
+{
+    pthread_mutex_lock(&m->statsLock);
+    m->stats.iterations += stats->iterations;
+    m->stats.cardioidSaved += stats->cardioidSaved;
+    m->stats.periodSaved += stats->periodSaved;
+    m->stats.derivativeSaved += stats->derivativeSaved;
+    m->stats.references += stats->references;
+    m->stats.seriesSkipped += stats->seriesSkipped;
+    m->stats.filledPixels += stats->filledPixels;
+    m->stats.antiAliasSamples += stats->antiAliasSamples;
+    m->stats.mirroredPixels += stats->mirroredPixels;
+    m->stats.resumedPixels += stats->resumedPixels;
+    pthread_mutex_unlock(&m->statsLock);
+}
+
+/**
+ * @brief Chooses the list kernel for the precision of the visualization.
+ * @param m The settings of the visualization.
+ * @return The kernel.
+ */
+listKernel chooseKernel(mandelData * m)
+{
+    if(!isStandardFormula(m)) return formulaKernels[m->formula][m->power - 2];
+
+    if(m->precision == MANDEL_PRECISION_FLOAT) return listKernelf;
+    if(m->precision == MANDEL_PRECISION_DOUBLEDOUBLE) return listKerneldd;
+    if(m->precision == MANDEL_PRECISION_PERTURBATION) return listKernelp;
+    if(m->precision == MANDEL_PRECISION_FIXED) return listKernelFixed;
+
+    return listKerneld;
+}
+
+/**
+ * @brief Saves the pixels of a rectangle that reached the iteration cap, so that a later render with a higher cap can continue them instead of starting over. Only used for the renders accepted by canResume.
+ * @param t The rectangle, with the results of all its pixels.
+ */
+void saveResumePoints(tileData * t)
+{
+    mandelData * m = t->m;
+    resumePoint * points = (resumePoint*) malloc(sizeof(resumePoint) * t->columns * t->rows);
+    int count = 0;
+
+    for(int r = 0; r < t->rows; r++) {
+        for(int c = 0; c < t->columns; c++) {
+            const brotStruct * b = &t->cells[cellIndex(t, c, r)];
+            int x = t->xScreen + c, y = t->yScreen + r;
+
+            if(b->n < m->iterations) continue;
+
+            double cx = m->location.x + tileX(t, c), cy = m->location.y + tileY(t, r);
+            if(inCardioidOrBulb(cx, cy)) continue;
+
+            points[count].pixel = y * m->width + x;
+            points[count].cx = cx;
+            points[count].cy = cy;
+            points[count].b = *b;
+            count++;
+        }
+    }
+
+    if(count > 0) {
+        pthread_mutex_lock(&m->statsLock);
+        m->resume = (resumePoint*) realloc(m->resume, sizeof(resumePoint) * (m->resumeCount + count));
+        memcpy(&m->resume[m->resumeCount], points, sizeof(resumePoint) * count);
+        m->resumeCount += count;
+        pthread_mutex_unlock(&m->statsLock);
+    }
+
+    free(points);
+}
+
+/**
+ * @brief Compares two resumePoint structs by their pixels, for qsort.
+ * @param a A resumePoint.
+ * @param b Another resumePoint.
+ * @return Negative, zero or positive as the pixel of a is before, the same as or after the pixel of b.
+ */
+int compareResumePoints(const void * a, const void * b)
+{
+    return ((const resumePoint*)a)->pixel - ((const resumePoint*)b)->pixel;
+}
+
+/**
+ * @brief Sorts the saved pixels in image order, so that the jobs continuing them get neighboring pixels.
+ * @param m The settings of the visualization.
+ */
+void sortResumePoints(mandelData * m)
+{
+    qsort(m->resume, m->resumeCount, sizeof(resumePoint), compareResumePoints);
+}
+
+/**
+ * @brief Calculates a band of rows of a rectangle.
+ * @param t The whole rectangle.
+ * @param r0 The first row of the band.
+ * @param r1 The last row of the band.
+ */
+void calculateTileRows(tileData t, int r0, int r1)
+{
+    if(r1 < r0) return;
+
+    t.yScreen += r0;
+    t.rows = r1 - r0 + 1;
+
+    t.cells = (brotStruct*) malloc(sizeof(brotStruct) * t.columns * t.rows);
+    if(t.m->rectangleChecking) calculateRectangleChecked(&t);
+    else calculateRectangleList(&t);
+    if(canResume(t.m)) saveResumePoints(&t);
+    free(t.cells);
+}
+
+/**
+ * @brief Calculates every pixel in a tile, with one sample per pixel. Anti-aliasing is done afterwards by antiAliasPixels, and the rows that mirror other rows of the visualization are copied afterwards by mirrorRows.
+ * @param tile The tile, in screen-coordinates.
+ * @param m Settings for the visualization.
+ */
+void calculateRectangle(pixelRect tile, mandelData * m)
+{
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+
+    tileData t = {m, tile.x, tile.y, tile.w, tile.h, chooseKernel(m), NULL, &stats};
+    int yScreen = tile.y;
+
+    //the mirrored rows are left out, which may split the rectangle in two
+    if(m->mirrorStart <= m->mirrorEnd && m->mirrorStart < yScreen + t.rows && m->mirrorEnd >= yScreen) {
+        calculateTileRows(t, 0, m->mirrorStart - yScreen - 1);
+        calculateTileRows(t, m->mirrorEnd - yScreen + 1, t.rows - 1);
+    } else {
+        calculateTileRows(t, 0, t.rows - 1);
+    }
+
+    addStats(m, &stats);
+}
+
+/**
+ * @brief Finds the rows of the visualization that are mirror images of other rows. The mandelbrot-set is symmetric about the real axis, so when the axis lies on a row or between two rows, the rows on one side of it are the rows on the other side upside down.
+ * @param m The settings of the visualization. Its mirrorAxis, mirrorStart and mirrorEnd are set, an empty range if nothing can be mirrored.
+ */
+void findMirrorRows(mandelData * m)
+{
+    m->mirrorAxis = 0;
+    m->mirrorStart = 1;
+    m->mirrorEnd = 0;
+
+    //the burning ship is not symmetric, and a julia-set only about the real axis when its seed is real
+    if(m->formula == MANDEL_FORMULA_BURNING_SHIP) return;
+    if(m->formula == MANDEL_FORMULA_JULIA && m->juliaY != 0.0) return;
+
+    //row y lies at originY + y*rowHeight, and its mirror image at -originY - y*rowHeight, which is row axis - y
+    //the origin is used in double-double, so that views deeper than double precision can be mirrored as well
+    double rowHeight = m->location.h / (double)m->height;
+    double axis = dd_toDouble(dd_div(dd_mul(m->originY, dd_fromDouble(-2.0)), dd_fromDouble(rowHeight)));
+    double rounded = floor(axis + 0.5);
+
+    if(fabs(axis - rounded) > MIRROR_TOLERANCE || rounded < 2.0 || rounded > 2.0 * (double)(m->height - 1)) return;
+
+    //the rows below the axis are copied from the ones above it
+    m->mirrorAxis = (int)rounded;
+    m->mirrorStart = m->mirrorAxis / 2 + 1;
+    m->mirrorEnd = m->mirrorAxis < m->height - 1 ? m->mirrorAxis : m->height - 1;
+}
+
+/**
+ * @brief Copies a part of the rows found by findMirrorRows from the rows they mirror.
+ * @param m The settings of the visualization.
+ * @param first The first row to copy, the rows outside the mirrored ones are skipped.
+ * @param last The last row to copy.
+ */
+void mirrorRowRange(mandelData * m, int first, int last)
+{
+    if(first < m->mirrorStart) first = m->mirrorStart;
+    if(last > m->mirrorEnd) last = m->mirrorEnd;
+
+    for(int y = first; y <= last; y++) {
+        int from = m->mirrorAxis - y;
+        for(int x = 0; x < m->width;) {
+            int run = pixelRun(m, x, m->width - x);
+            memcpy(&m->image[pixelOffset(m, x, y)], &m->image[pixelOffset(m, x, from)], sizeof(unsigned int) * run);
+            memcpy(&m->counts[pixelOffset(m, x, y)], &m->counts[pixelOffset(m, x, from)], sizeof(int) * run);
+            x += run;
+        }
+    }
+}
+
+/**
+ * @brief Copies the rows found by findMirrorRows from the rows they mirror.
+ * @param m The settings of the visualization.
+ */
+void mirrorRows(mandelData * m)
+{
+    mirrorRowRange(m, m->mirrorStart, m->mirrorEnd);
+}
+
+/**
+ * @brief Adds the pixels copied by mirrorRows to the statistics of the render, once per render however many times the rows are copied.
+ * @param m The settings of the visualization.
+ */
+void addMirroredStats(mandelData * m)
+{
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+    if(m->mirrorStart <= m->mirrorEnd) stats.mirroredPixels = (long long)(m->mirrorEnd - m->mirrorStart + 1) * m->width;
+    addStats(m, &stats);
+}
+
+/**
+ * @brief Reads a monotonic clock.
+ * @return The time in seconds since some fixed point.
+ */
+double monotonicSeconds(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Gets a number of the Halton sequence, used to spread the anti-aliasing samples of a pixel evenly however many are taken.
+ * @param i The index in the sequence, starting at 1.
+ * @param base The base of the sequence.
+ * @return A number between 0 and 1.
+ */
+double halton(int i, int base)
+{
+    double f = 1.0, v = 0.0;
+
+    while(i > 0) {
+        f /= (double)base;
+        v += f * (double)(i % base);
+        i /= base;
+    }
+
+    return v;
+}
+
+/**
+ * @brief Gets the largest difference between the channels of two colors.
+ * @param a A color.
+ * @param b Another color.
+ * @return The difference, between 0 and 255.
+ */
+int colorDifference(unsigned int a, unsigned int b)
+{
+    int diff = 0;
+
+    for(int shift = 0; shift <= 16; shift += 8) {
+        int d = abs((int)((a >> shift) & 255) - (int)((b >> shift) & 255));
+        if(d > diff) diff = d;
+    }
+
+    return diff;
+}
+
+/**
+ * @brief Finds the pixels of a rendered image that differ strongly from a neighbor, in color or in iteration-count. Those are the pixels at edges and in bands too thin to be resolved by one sample, where aliasing shows.
+ * @param m The settings of the visualization, with its image and counts rendered.
+ * @param count Set to the number of pixels found.
+ * @return The indices of the pixels, to be freed by the caller.
+ */
+int * findAntiAliasPixels(mandelData * m, int * count)
+{
+    int * pixels = (int*) malloc(sizeof(int) * m->width * m->height);
+    *count = 0;
+
+    //in the tiled layout the pixels are found block by block, so that the jobs of the pass get the pixels of a few blocks each
+    int blockWidth = m->tiledLayout ? TILED_BLOCK : m->width;
+    int blockHeight = m->tiledLayout ? TILED_BLOCK : m->height;
+
+    for(int by = 0; by < m->height; by += blockHeight) {
+        for(int bx = 0; bx < m->width; bx += blockWidth) {
+            for(int y = by; y < by + blockHeight && y < m->height; y++) {
+                //the mirrored rows get the anti-aliased pixels of the rows they mirror
+                if(y >= m->mirrorStart && y <= m->mirrorEnd) continue;
+
+                for(int x = bx; x < bx + blockWidth && x < m->width; x++) {
+                    int a = pixelOffset(m, x, y);
+                    bool differs = false;
+
+                    for(int dy = -1; dy <= 1 && !differs; dy++) {
+                        for(int dx = -1; dx <= 1 && !differs; dx++) {
+                            if((dx != 0) == (dy != 0) || x + dx < 0 || x + dx >= m->width || y + dy < 0 || y + dy >= m->height) continue;
+
+                            int b = pixelOffset(m, x + dx, y + dy);
+                            differs = colorDifference(m->image[a], m->image[b]) > AA_COLOR_THRESHOLD || abs(m->counts[a] - m->counts[b]) > AA_COUNT_THRESHOLD;
+                        }
+                    }
+
+                    if(differs) pixels[(*count)++] = y * m->width + x;
+                }
+            }
+        }
+    }
+
+    return pixels;
+}
+
+/**
+ * @brief Supersamples pixels progressively. Every round adds BROT_LANES samples to each pixel, all iterated as one list, and a pixel is done when a round no longer changes its mean color or it has antiAliasSamples samples.
+ * @param m The settings of the visualization. The colors of the pixels in its image are used as their first samples, and replaced by the mean colors.
+ * @param pixels The indices of the pixels.
+ * @param count The number of pixels.
+ * @param deadline No round is started after this time, from monotonicSeconds, DBL_MAX for no deadline.
+ * @param stats Iteration counters of the calling job.
+ * @return false if the deadline stopped the pixels before they were done.
+ */
+bool antiAliasPixels(mandelData * m, const int * pixels, int count, double deadline, mandelStats * stats)
+{
+    listKernel kernel = chooseKernel(m);
+    double pixelWidth = m->location.w / (double)m->width;
+    double pixelHeight = m->location.h / (double)m->height;
+    int rounds = (m->antiAliasSamples - 1) / BROT_LANES;
+
+    double * ox = (double*) malloc(sizeof(double) * count * BROT_LANES);
+    double * oy = (double*) malloc(sizeof(double) * count * BROT_LANES);
+    brotStruct * samples = (brotStruct*) malloc(sizeof(brotStruct) * count * BROT_LANES);
+    unsigned int * sums = (unsigned int*) malloc(sizeof(unsigned int) * count * 3);
+    int * active = (int*) malloc(sizeof(int) * count);
+    int numActive = count;
+
+    for(int a = 0; a < count; a++) {
+        unsigned int c = m->image[indexOffset(m, pixels[a])];
+        sums[a * 3] = (c >> 0) & 255;
+        sums[a * 3 + 1] = (c >> 8) & 255;
+        sums[a * 3 + 2] = (c >> 16) & 255;
+        active[a] = a;
+    }
+
+    bool finished = true;
+    for(int round = 0; round < rounds && numActive > 0; round++) {
+        if(deadline < DBL_MAX && monotonicSeconds() >= deadline) {
+            finished = false;
+            break;
+        }
+
+        int taken = 1 + round * BROT_LANES;
+
+        for(int a = 0; a < numActive; a++) {
+            int x = pixels[active[a]] % m->width, y = pixels[active[a]] / m->width;
+
+            for(int l = 0; l < BROT_LANES; l++) {
+                int i = taken + l;
+                ox[a * BROT_LANES + l] = ((double)x + halton(i, 2) - 0.5) * pixelWidth;
+                oy[a * BROT_LANES + l] = ((double)y + halton(i, 3) - 0.5) * pixelHeight;
+            }
+        }
+        kernel(m, ox, oy, numActive * BROT_LANES, m->interiorDetection, samples, stats);
+        stats->antiAliasSamples += numActive * BROT_LANES;
+
+        int stillActive = 0;
+        for(int a = 0; a < numActive; a++) {
+            unsigned int * sum = &sums[active[a] * 3];
+            unsigned int before = (sum[0] / taken) | ((sum[1] / taken) << 8) | ((sum[2] / taken) << 16) | (255 << 24);
+
+            for(int l = 0; l < BROT_LANES; l++) {
+                unsigned int c = colorBrot(samples[a * BROT_LANES + l], m);
+                sum[0] += (c >> 0) & 255;
+                sum[1] += (c >> 8) & 255;
+                sum[2] += (c >> 16) & 255;
+            }
+
+            int total = taken + BROT_LANES;
+            unsigned int after = (sum[0] / total) | ((sum[1] / total) << 8) | ((sum[2] / total) << 16) | (255 << 24);
+            m->image[indexOffset(m, pixels[active[a]])] = after;
+
+            if(colorDifference(before, after) >= AA_CONVERGED) active[stillActive++] = active[a];
+        }
+        numActive = stillActive;
+    }
+
+    free(ox);
+    free(oy);
+    free(samples);
+    free(sums);
+    free(active);
+
+    return finished;
+}
+
+/**
+ * @brief Finds the largest magnitude of the coordinates used when rendering a visualization.
+ * @param m The settings of the visualization.
+ * @return The largest magnitude, at least 2.
+ */
+double coordinateScale(mandelData * m)
+{
+    //the orbits are bounded by 2, but the coordinates of the view itself may be larger
+    double scale = 2.0;
+    scale = fmax(scale, fabs(m->location.x));
+    scale = fmax(scale, fabs(m->location.x + m->location.w));
+    scale = fmax(scale, fabs(m->location.y));
+    scale = fmax(scale, fabs(m->location.y + m->location.h));
+
+    return scale;
+}
+
+/**
+ * @brief Chooses the cheapest precision that can still resolve a pixel of the visualization.
+ * @param m The settings of the visualization.
+ * @return The precision the kernels should use.
+ */
+mandelPrecision choosePrecision(mandelData * m)
+{
+    double pixelSize = fabs(m->location.w) / (double)m->width;
+    double scale = coordinateScale(m);
+
+    //the formula kernels only exist in double precision
+    if(!isStandardFormula(m)) return MANDEL_PRECISION_DOUBLE;
+
+    if(pixelSize >= scale * FLT_EPSILON * PRECISION_MARGIN) return MANDEL_PRECISION_FLOAT;
+    if(pixelSize >= scale * DBL_EPSILON * PRECISION_MARGIN) return MANDEL_PRECISION_DOUBLE;
+    if(m->perturbation) return MANDEL_PRECISION_PERTURBATION;
+    if(pixelSize >= scale * DOUBLEDOUBLE_EPSILON * PRECISION_MARGIN) return MANDEL_PRECISION_DOUBLEDOUBLE;
+
+    return MANDEL_PRECISION_FIXED;
+}
+
+/**
+ * @brief Chooses the width of the fixed-point numbers used for reference orbits and the fixed-point kernel.
+ * @param m The settings of the visualization.
+ * @return The number of bits, 0 if double-double is precise enough.
+ */
+int chooseFixedBits(mandelData * m)
+{
+    double pixelSize = fabs(m->location.w) / (double)m->width;
+
+    if(pixelSize >= coordinateScale(m) * DOUBLEDOUBLE_EPSILON * PRECISION_MARGIN) return 0;
+
+    return fixed_bitsFor(pixelSize, PRECISION_MARGIN);
+}
+
+/**
+ * @brief Compares two ints, for qsort.
+ * @param a An int.
+ * @param b Another int.
+ * @return Negative, zero or positive as a is smaller than, equal to or larger than b.
+ */
+int compareInts(const void * a, const void * b)
+{
+    return *(const int*)a - *(const int*)b;
+}
+
+/**
+ * @brief Chooses the iteration cap of a visualization from the escape-counts of a coarse probe of it. The probe is iterated with a cap that is doubled as long as nothing or a noticeable part of it escapes in the last half of the cap, and the chosen cap is the smallest one that leaves at most AUTO_UNRESOLVED_FRACTION of the probe escaping after it.
+ * @param m The settings of the visualization, with its precision chosen. Its iterations are set, and so is its reference when perturbation is used.
+ * @param stats Iteration counters for the probe.
+ */
+void chooseIterations(mandelData * m, mandelStats * stats)
+{
+    int count = AUTO_PROBE_SIZE * AUTO_PROBE_SIZE;
+    int allowed = (int)(AUTO_UNRESOLVED_FRACTION * (double)count);
+    double * ox = (double*) malloc(sizeof(double) * count);
+    double * oy = (double*) malloc(sizeof(double) * count);
+    brotStruct * probe = (brotStruct*) malloc(sizeof(brotStruct) * count);
+    int * escaped = (int*) malloc(sizeof(int) * count);
+    listKernel kernel = chooseKernel(m);
+
+    for(int a = 0; a < count; a++) {
+        ox[a] = ((double)(a % AUTO_PROBE_SIZE) + 0.5) / (double)AUTO_PROBE_SIZE * m->location.w;
+        oy[a] = ((double)(a / AUTO_PROBE_SIZE) + 0.5) / (double)AUTO_PROBE_SIZE * m->location.h;
+    }
+
+    int cap = AUTO_MIN_ITERATIONS, numEscaped = 0;
+    for(;;) {
+        m->iterations = cap;
+        if(m->precision == MANDEL_PRECISION_PERTURBATION) {
+            if(m->reference != NULL) perturb_destroyOrbit(m->reference);
+            m->reference = createReference(m, m->location.w / 2.0, m->location.h / 2.0);
+        }
+        //without the derivative test, every interior point of the probe would cost the whole cap
+        kernel(m, ox, oy, count, true, probe, stats);
+
+        int late = 0;
+        numEscaped = 0;
+        for(int a = 0; a < count; a++) {
+            if(probe[a].n >= cap) continue;
+            escaped[numEscaped++] = probe[a].n;
+            if(probe[a].n > cap / 2) late++;
+        }
+
+        //deep in a zoom the whole view may need more than the cap before anything escapes
+        if((late <= allowed && numEscaped > 0) || cap >= AUTO_MAX_ITERATIONS) break;
+        cap *= 2;
+    }
+
+    //the escape-counts are sorted, so that the count that only allowed points are above can be read
+    qsort(escaped, numEscaped, sizeof(int), compareInts);
+    int chosen = numEscaped > allowed ? escaped[numEscaped - allowed - 1] + 1 : AUTO_MIN_ITERATIONS;
+    if(chosen < AUTO_MIN_ITERATIONS) chosen = AUTO_MIN_ITERATIONS;
+    if(chosen > cap) chosen = cap;
+    m->iterations = chosen;
+
+    free(ox);
+    free(oy);
+    free(probe);
+    free(escaped);
+}
+
+/**
+ * @brief Compares the estimated costs of two jobs for qsort, so that the most expensive job comes first.
+ * @param a A pointer to the first job.
+ * @param b A pointer to the second job.
+ * @return -1, 0 or 1.
+ */
+int compareJobCosts(const void * a, const void * b)
+{
+    double x = (*(mandelJobArg * const *)a)->cost, y = (*(mandelJobArg * const *)b)->cost;
+    return (x < y) - (x > y);
+}
+
+/**
+ * @brief Estimates the cost of a part of the image by iterating a grid of COST_PROBES*COST_PROBES points over it. The iterations calculated are used rather than the iteration-counts, since the interior points found by the cardioid, periodicity or derivative tests cost far less than the cap. The mirrored rows are not calculated, so they cost nothing.
+ * @param m The settings of the visualization.
+ * @param r The part, it may have no pixels.
+ * @param kernel The kernel of the visualization.
+ * @param stats Iteration counters for the probe.
+ * @return The estimated cost, in iterations.
+ */
+double probeCost(mandelData * m, pixelRect r, listKernel kernel, mandelStats * stats)
+{
+    int rows = r.h;
+    int from = r.y > m->mirrorStart ? r.y : m->mirrorStart;
+    int to = r.y + r.h - 1 < m->mirrorEnd ? r.y + r.h - 1 : m->mirrorEnd;
+    if(from <= to) rows -= to - from + 1;
+    if(rows <= 0 || r.w <= 0) return 0.0;
+
+    int probes = COST_PROBES * COST_PROBES;
+    double ox[COST_PROBES * COST_PROBES], oy[COST_PROBES * COST_PROBES];
+    brotStruct probe[COST_PROBES * COST_PROBES];
+
+    //the probe points lie in the middles of the cells of the grid
+    for(int p = 0; p < probes; p++) {
+        ox[p] = ((double)r.x + ((double)(p % COST_PROBES) + 0.5) / COST_PROBES * (double)r.w) / (double)m->width * m->location.w;
+        oy[p] = ((double)r.y + ((double)(p / COST_PROBES) + 0.5) / COST_PROBES * (double)r.h) / (double)m->height * m->location.h;
+    }
+
+    long long before = stats->iterations;
+    kernel(m, ox, oy, probes, m->interiorDetection, probe, stats);
+    double n = (double)(stats->iterations - before) / (double)probes;
+
+    return (n + COST_PIXEL_OVERHEAD) * (double)(rows * r.w);
+}
+
+/**
+ * @brief Divides the tile of a job into quarters and estimates their costs, which add up to the cost of the tile.
+ * @param jobArg The job.
+ */
+void probeQuarters(mandelJobArg * jobArg)
+{
+    mandelData * m = jobArg->data;
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+    listKernel kernel = chooseKernel(m);
+    pixelRect t = jobArg->tile;
+    int left = (t.w + 1) / 2, top = (t.h + 1) / 2;
+
+    jobArg->cost = 0.0;
+    for(int a = 0; a < 4; a++) {
+        pixelRect * q = &jobArg->quarters[a];
+        q->x = a % 2 == 0 ? t.x : t.x + left;
+        q->y = a / 2 == 0 ? t.y : t.y + top;
+        q->w = a % 2 == 0 ? left : t.w - left;
+        q->h = a / 2 == 0 ? top : t.h - top;
+        jobArg->quarterCosts[a] = probeCost(m, *q, kernel, &stats);
+        jobArg->cost += jobArg->quarterCosts[a];
+    }
+    jobArg->probed = true;
+
+    addStats(m, &stats);
+}
+
+/**
+ * @brief The function called by the threadpool to estimate the cost of a tile before the tiles are started. Decodes the void pointer.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void probeJob(void * arg)
+{
+    probeQuarters((mandelJobArg*) arg);
+}
+
+/**
+ * @brief The function called by the threadpool. Decodes the void pointer. A tile estimated to cost more than its target is not calculated, but split into one job per quarter, added to the pool with the most expensive first. The quarters are probed when they decide whether to split in turn, so the work follows the structure of the set, and the small expensive parts of a view are spread over the threads instead of being left to one of them.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void mandelJob(void * arg)
+{
+    mandelJobArg * jobArg = (mandelJobArg*) arg;
+    pixelRect t = jobArg->tile;
+    int thread = threadpool_currentThread(jobArg->pool);
+
+    if(jobArg->cost <= jobArg->target || (t.w <= TILE_MIN_SIZE && t.h <= TILE_MIN_SIZE)) {
+        while(jobArg != NULL) {
+            mandelJobArg * next = jobArg->merged;
+            calculateRectangle(jobArg->tile, jobArg->data);
+            free(jobArg);
+            jobArg = next;
+        }
+        return;
+    }
+
+    if(!jobArg->probed) probeQuarters(jobArg);
+
+    mandelJobArg * children[4];
+    int count = 0;
+    for(int a = 0; a < 4; a++) {
+        if(jobArg->quarters[a].w <= 0 || jobArg->quarters[a].h <= 0) continue;
+
+        mandelJobArg * child = (mandelJobArg*) malloc(sizeof(mandelJobArg));
+        *child = *jobArg;
+        child->tile = jobArg->quarters[a];
+        child->cost = jobArg->quarterCosts[a];
+        child->probed = false;
+        child->key = -1;
+        child->merged = NULL;
+        children[count++] = child;
+    }
+    qsort(children, count, sizeof(mandelJobArg*), compareJobCosts);
+
+    //the quarters stay with this thread, where the other threads take them from when they run out of work
+    for(int a = 0; a < count; a++) {
+        threadpool_enqueueTo(jobArg->pool, mandelJob, children[a], thread);
+    }
+    free(jobArg);
+}
+
+/**
+ * @brief Sets the target of the probed tiles and merges runs of cheap neighbors into one job, so that a view with many cheap tiles is not spread over a job per tile. Only tiles that follow each other in Hilbert order and are given to the same thread are merged, and a merged job costs at most the target.
+ * @param m The settings of the visualization.
+ * @param jobs The probed tiles in Hilbert order, replaced by the jobs. A merged tile is reached from the merged field of the tile before it.
+ * @param numTiles The number of tiles.
+ * @param target The estimated cost of a job, in iterations.
+ * @return The number of jobs.
+ */
+int mergeTiles(mandelData * m, mandelJobArg ** jobs, int numTiles, double target)
+{
+    int numJobs = 0;
+    mandelJobArg * head = NULL, * tail = NULL;
+
+    for(int a = 0; a < numTiles; a++) {
+        mandelJobArg * j = jobs[a];
+        j->target = target;
+
+        if(head != NULL && head->cost + j->cost <= target && m->tileThreads[head->key] == m->tileThreads[j->key]) {
+            tail->merged = j;
+            tail = j;
+            head->cost += j->cost;
+            continue;
+        }
+
+        jobs[numJobs++] = j;
+        head = j->cost < target ? j : NULL;
+        tail = j;
+    }
+
+    return numJobs;
+}
+
+/**
+ * @brief The function called by the threadpool to continue saved pixels to a higher iteration cap. Decodes the void pointer.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void resumeJob(void * arg)
+{
+    resumeJobArg * jobArg = (resumeJobArg*) arg;
+    mandelData * m = jobArg->data;
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+
+    //float views were iterated by the lane kernel, so their orbits are continued by it too, or they would not match a fresh render
+    if(m->precision == MANDEL_PRECISION_FLOAT) {
+        float * cx = (float*) malloc(sizeof(float) * jobArg->count);
+        float * cy = (float*) malloc(sizeof(float) * jobArg->count);
+        brotStruct * from = (brotStruct*) malloc(sizeof(brotStruct) * jobArg->count);
+        brotStruct * out = (brotStruct*) malloc(sizeof(brotStruct) * jobArg->count);
+
+        for(int a = 0; a < jobArg->count; a++) {
+            cx[a] = (float)jobArg->points[a].cx;
+            cy[a] = (float)jobArg->points[a].cy;
+            from[a] = jobArg->points[a].b;
+        }
+
+        inBrotListf(cx, cy, jobArg->count, m->iterations, m->interiorDetection, (float)periodEpsilon(m, PERIOD_EPSILON_F), out, from, &stats);
+
+        for(int a = 0; a < jobArg->count; a++) {
+            resumePoint * p = &jobArg->points[a];
+            p->b = out[a];
+
+            if(p->b.n < m->iterations) {
+                m->image[indexOffset(m, p->pixel)] = colorBrot(p->b, m);
+                m->counts[indexOffset(m, p->pixel)] = p->b.n;
+                p->pixel = -1;
+            }
+
+            //the lanes do not tell periodic orbits apart from the ones that reached the cap, so both are kept
+        }
+
+        free(cx);
+        free(cy);
+        free(from);
+        free(out);
+        stats.resumedPixels = jobArg->count;
+
+        addStats(m, &stats);
+        free(jobArg);
+        return;
+    }
+
+    for(int a = 0; a < jobArg->count; a++) {
+        resumePoint * p = &jobArg->points[a];
+        long long saved = stats.periodSaved + stats.derivativeSaved;
+        p->b = continueBrotDist(p->cx, p->cy, p->b, m->iterations, m->interiorDetection, periodEpsilon(m, PERIOD_EPSILON), &stats);
+
+        if(p->b.n < m->iterations) {
+            m->image[indexOffset(m, p->pixel)] = colorBrot(p->b, m);
+            m->counts[indexOffset(m, p->pixel)] = p->b.n;
+            p->pixel = -1;
+        } else if(stats.periodSaved + stats.derivativeSaved > saved) {
+            //the orbit was found to be periodic, so it will never escape however high the cap is
+            p->pixel = -1;
+        }
+
+        //the other pixels are kept for the next increase of the cap
+    }
+    stats.resumedPixels = jobArg->count;
+
+    addStats(m, &stats);
+    free(jobArg);
+}
+
+/**
+ * @brief The function called by the threadpool for the anti-aliasing pass. Decodes the void pointer.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void antiAliasJob(void * arg)
+{
+    antiAliasJobArg * jobArg = (antiAliasJobArg*) arg;
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, jobArg->data->precision, jobArg->data->fixedBits};
+
+    bool finished = antiAliasPixels(jobArg->data, jobArg->pixels, jobArg->count, jobArg->deadline, &stats);
+    addStats(jobArg->data, &stats);
+
+    if(!finished) {
+        pthread_mutex_lock(&jobArg->data->statsLock);
+        *jobArg->cut = true;
+        pthread_mutex_unlock(&jobArg->data->statsLock);
+    }
+    free(jobArg);
+}
+
+/**
+ * @brief The function called by the threadpool to run a buddhabrot chain. Decodes the void pointer.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void buddhaJob(void * arg)
+{
+    buddhaJobArg * jobArg = (buddhaJobArg*) arg;
+    mandelData * m = jobArg->data;
+    buddhaChain * c = jobArg->chain;
+
+    buddha_seed(c, &jobArg->view, m->iterations, BUDDHA_SEED_ATTEMPTS);
+    buddha_run(c, &jobArg->view, m->iterations, jobArg->samples);
+
+    mandelStats stats = {c->iterations, c->cardioidSaved, c->periodSaved, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+    addStats(m, &stats);
+    free(jobArg);
+}
+
+/**
+ * @brief The function called by the threadpool to add the histograms of some buddhabrot chains to the densities, for a band of pixels. Decodes the void pointer.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void buddhaMergeJob(void * arg)
+{
+    buddhaMergeJobArg * jobArg = (buddhaMergeJobArg*) arg;
+
+    for(int p = jobArg->from; p < jobArg->to; p++) {
+        float sum = 0.0f;
+        for(int a = 0; a < jobArg->numChains; a++) sum += jobArg->chains[a]->histogram[p];
+        jobArg->density[p] += sum;
+    }
+
+    free(jobArg);
+}
+
+/**
+ * @brief Compares two floats for qsort.
+ * @param a The first float.
+ * @param b The second float.
+ * @return -1, 0 or 1.
+ */
+int compareFloats(const void * a, const void * b)
+{
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Estimates a quantile of the densities of a buddhabrot from pixels spread over the image.
+ * @param density The densities.
+ * @param pixels The number of pixels.
+ * @param quantile The quantile, between 0 and 1.
+ * @return The estimated density of the quantile.
+ */
+float densityQuantile(const float * density, int pixels, double quantile)
+{
+    int count = pixels < BUDDHA_QUANTILE_SAMPLES ? pixels : BUDDHA_QUANTILE_SAMPLES;
+    float * samples = (float*) malloc(sizeof(float) * count);
+
+    for(int a = 0; a < count; a++) samples[a] = density[(long long)pixels * a / count];
+    qsort(samples, count, sizeof(float), compareFloats);
+
+    float q = samples[(int)(quantile * (count - 1))];
+    free(samples);
+
+    return q;
+}
+
+/**
+ * @brief Gets the threadpool of a visualization. It is kept from one render to the next, so that every tile is given to the same thread every time, and created again when the number of threads changes. The tiles are given out by rows of tiles, so that the first render writes every page of a row on one thread, which places the pages in the memory of its NUMA node, and the later renders keep using them there. With mandel_setThreadPinning the threads are pinned to the cpus of their nodes, so that they stay on the nodes of their pages; otherwise the placement is only a hint that lasts as long as the scheduler leaves the threads where they are.
+ * @param m The settings of the visualization.
+ * @param numthreads The number of threads.
+ * @return The threadpool.
+ */
+struct threadpool * renderPool(mandelData * m, int numthreads)
+{
+    if(m->pool != NULL && m->poolThreads == numthreads) return m->pool;
+
+    if(m->pool != NULL) threadpool_destroy(m->pool);
+    m->pool = threadpool_create(numthreads);
+    m->poolThreads = numthreads;
+    if(m->pinThreads) threadpool_pinThreads(m->pool);
+
+    int columns = (m->width + TILE_SIZE - 1) / TILE_SIZE, rows = (m->height + TILE_SIZE - 1) / TILE_SIZE;
+    for(int a = 0; a < columns * rows; a++) m->tileThreads[a] = a / columns % numthreads;
+
+    return m->pool;
+}
+
+/**
+ * @brief The function called by the threadpool to copy the mirrored rows of a row of tiles. Decodes the void pointer.
+ * @param arg The arguments supplied by the user when the job was created.
+ */
+void mirrorJob(void * arg)
+{
+    mirrorJobArg * jobArg = (mirrorJobArg*) arg;
+    mirrorRowRange(jobArg->data, jobArg->first, jobArg->last);
+    free(jobArg);
+}
+
+/**
+ * @brief Copies the rows found by findMirrorRows with one job per row of tiles, given to the thread that owns the row in the pool from renderPool. The first write of a mirrored row places its pages, so they are placed with the rest of their row of tiles rather than on the thread that waits for the render.
+ * @param m The settings of the visualization.
+ * @param p The pool from renderPool.
+ */
+void mirrorRowsInPool(mandelData * m, struct threadpool * p)
+{
+    int columns = (m->width + TILE_SIZE - 1) / TILE_SIZE;
+
+    for(int r = m->mirrorStart / TILE_SIZE; r <= m->mirrorEnd / TILE_SIZE && m->mirrorStart <= m->mirrorEnd; r++) {
+        mirrorJobArg * jobArg = (mirrorJobArg*) malloc(sizeof(mirrorJobArg));
+        jobArg->data = m;
+        jobArg->first = r * TILE_SIZE;
+        jobArg->last = r * TILE_SIZE + TILE_SIZE - 1;
+        threadpool_enqueueTo(p, mirrorJob, jobArg, m->tileThreads[r * columns]);
+    }
+    threadpool_wait(p);
+}
+
+/**
+ * @brief Renders a visualization in the buddhabrot render mode. Every thread runs its own chain into its own histogram, so the threads share nothing until the histograms are merged, band by band, when all of them are done. A histogram is as large as the image, so only as many chains as have histograms within BUDDHA_HISTOGRAM_BYTES run at the same time; the others run in later waves, after the histograms of the earlier ones have been merged and freed.
+ * @param m The settings of the visualization.
+ * @param numthreads The number of threads, and of chains.
+ */
+void renderBuddhabrot(mandelData * m, int numthreads)
+{
+    int pixels = m->width * m->height;
+    long long samples = (long long)m->buddhabrotSamples * pixels;
+
+    buddhaView view;
+    view.x = m->location.x;
+    view.y = m->location.y;
+    view.w = m->location.w;
+    view.h = m->location.h;
+    view.width = m->width;
+    view.height = m->height;
+
+    m->precision = MANDEL_PRECISION_DOUBLE;
+    m->fixedBits = 0;
+    pthread_mutex_lock(&m->statsLock);
+    m->stats = (mandelStats) {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits
+    };
+    pthread_mutex_unlock(&m->statsLock);
+
+    int perWave = (int)(BUDDHA_HISTOGRAM_BYTES / (sizeof(float) * (size_t)pixels));
+    if(perWave < 1) perWave = 1;
+    if(perWave > numthreads) perWave = numthreads;
+
+    buddhaChain ** chains = (buddhaChain**) malloc(sizeof(buddhaChain*) * perWave);
+    float * density = (float*) calloc(pixels, sizeof(float));
+    struct threadpool * p = renderPool(m, numthreads);
+
+    for(int first = 0; first < numthreads; first += perWave) {
+        int count = numthreads - first < perWave ? numthreads - first : perWave;
+
+        for(int a = 0; a < count; a++) {
+            chains[a] = buddha_createChain(&view, m->iterations, (unsigned long long)(first + a));
+
+            buddhaJobArg * jobArg = (buddhaJobArg*) malloc(sizeof(buddhaJobArg));
+            jobArg->data = m;
+            jobArg->chain = chains[a];
+            jobArg->view = view;
+            jobArg->samples = samples * (first + a + 1) / numthreads - samples * (first + a) / numthreads;
+            threadpool_enqueue(p, buddhaJob, jobArg);
+        }
+        threadpool_wait(p);
+
+        for(int a = 0; a < numthreads; a++) {
+            buddhaMergeJobArg * jobArg = (buddhaMergeJobArg*) malloc(sizeof(buddhaMergeJobArg));
+            jobArg->chains = chains;
+            jobArg->numChains = count;
+            jobArg->density = density;
+            jobArg->from = (int)((long long)pixels * a / numthreads);
+            jobArg->to = (int)((long long)pixels * (a + 1) / numthreads);
+            threadpool_enqueue(p, buddhaMergeJob, jobArg);
+        }
+        threadpool_wait(p);
+
+        for(int a = 0; a < count; a++) buddha_destroyChain(chains[a]);
+    }
+
+    float white = densityQuantile(density, pixels, BUDDHA_WHITE_QUANTILE);
+
+    for(int a = 0; a < pixels; a++) {
+        double v = white > 0.0f ? sqrt(density[a] / white) : 0.0;
+        m->image[indexOffset(m, a)] = color_sampleOnce(m->c, BUDDHA_PALETTE_RANGE * (v < 1.0 ? v : 1.0));
+        m->counts[indexOffset(m, a)] = 0;
+    }
+
+    free(chains);
+    free(density);
+}
+
+/**
+ * @brief The function called by the thread created by mandel_renderUnifinished.
+ * @param arg a threadArgs struct cast as a void pointer.
+ */
+void * threadFunc(void * arg)
+{
+    struct threadArgs * t = (struct threadArgs *)arg;
+    mandel_render(t->m, t->numthreads, t->split);
+    free(t);
+    pthread_exit(NULL);
+    return NULL;
+}
+
+
+/**
+ * @brief Supersamples a list of pixels, split into split*split jobs.
+ * @param m The settings of the visualization.
+ * @param numthreads The number of threads.
+ * @param split The square root of the number of jobs.
+ * @param pixels The indices of the pixels.
+ * @param count The number of pixels.
+ * @param deadline The jobs start no round after this time, from monotonicSeconds, DBL_MAX for no deadline.
+ * @return false if the deadline stopped some of the pixels before they were done.
+ */
+bool antiAliasList(mandelData * m, int numthreads, int split, const int * pixels, int count, double deadline)
+{
+    int numJobs = split * split;
+    bool cut = false;
+
+    struct threadpool * p = renderPool(m, numthreads);
+    for(int a = 0; a < numJobs; a++) {
+        antiAliasJobArg * jobArg = (antiAliasJobArg*) malloc(sizeof(antiAliasJobArg));
+        jobArg->data = m;
+        jobArg->pixels = &pixels[(long long)count * a / numJobs];
+        jobArg->count = (int)((long long)count * (a + 1) / numJobs - (long long)count * a / numJobs);
+        jobArg->deadline = deadline;
+        jobArg->cut = &cut;
+        threadpool_enqueue(p, antiAliasJob, jobArg);
+    }
+    threadpool_wait(p);
+
+    return !cut;
+}
+
+/**
+ * @brief Runs the anti-aliasing pass over a rendered image. The pixels that differ from their neighbors are supersampled, split into split*split jobs. The colors the pixels had before are kept while the render can be resumed, so that restoreAliasedPixels can undo the pass.
+ * @param m The settings of the visualization.
+ * @param numthreads The number of threads.
+ * @param split The square root of the number of jobs.
+ */
+void antiAliasImage(mandelData * m, int numthreads, int split)
+{
+    m->aliasedCount = 0;
+
+    //the distance render mode is already smooth with one sample per pixel
+    if(m->antiAliasSamples <= 1 || m->renderMode != MANDEL_RENDER_ESCAPE_TIME) return;
+
+    int count = 0;
+    int * pixels = findAntiAliasPixels(m, &count);
+
+    if(m->resumeIterations > 0) {
+        m->aliasedPixels = (int*) realloc(m->aliasedPixels, sizeof(int) * (count > 0 ? count : 1));
+        m->aliasedColors = (unsigned int*) realloc(m->aliasedColors, sizeof(unsigned int) * (count > 0 ? count : 1));
+        for(int a = 0; a < count; a++) {
+            m->aliasedPixels[a] = pixels[a];
+            m->aliasedColors[a] = m->image[indexOffset(m, pixels[a])];
+        }
+        m->aliasedCount = count;
+    }
+
+    antiAliasList(m, numthreads, split, pixels, count, DBL_MAX);
+
+    free(pixels);
+    mirrorRows(m);
+}
+
+/**
+ * @brief Undoes the last anti-aliasing pass of antiAliasImage, by giving the pixels it supersampled their colors of one sample again.
+ * @param m The settings of the visualization.
+ */
+void restoreAliasedPixels(mandelData * m)
+{
+    for(int a = 0; a < m->aliasedCount; a++) {
+        m->image[indexOffset(m, m->aliasedPixels[a])] = m->aliasedColors[a];
+    }
+    m->aliasedCount = 0;
+}
+
+/**
+ * @brief Renders a visualization again after its iteration cap has been raised. Only the pixels saved by saveResumePoints are iterated, from where they stopped, and the pixels that escaped before are kept as they are. The anti-aliasing pass is undone and run over the whole image again, as its samples were taken at the old cap, so that the image is the same as a new render.
+ * @param m The settings of the visualization.
+ * @param numthreads The number of threads.
+ * @param split The square root of the number of jobs.
+ */
+void resumeRender(mandelData * m, int numthreads, int split)
+{
+    int numJobs = split * split;
+
+    pthread_mutex_lock(&m->statsLock);
+    m->stats = (mandelStats) {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits
+    };
+    pthread_mutex_unlock(&m->statsLock);
+
+    restoreAliasedPixels(m);
+
+    //the pixels that reached the old cap are counted at the new one, like in a new render, until they escape
+    for(size_t a = 0; a < pixelStorage(m); a++) {
+        if(m->counts[a] >= m->resumeIterations) m->counts[a] = m->iterations;
+    }
+
+    struct threadpool * p = renderPool(m, numthreads);
+    for(int a = 0; a < numJobs; a++) {
+        resumeJobArg * jobArg = (resumeJobArg*) malloc(sizeof(resumeJobArg));
+        jobArg->data = m;
+        jobArg->points = &m->resume[(long long)m->resumeCount * a / numJobs];
+        jobArg->count = (int)((long long)m->resumeCount * (a + 1) / numJobs - (long long)m->resumeCount * a / numJobs);
+        threadpool_enqueue(p, resumeJob, jobArg);
+    }
+    threadpool_wait(p);
+
+    //the pixels that escaped are not needed any more
+    int count = 0;
+    for(int a = 0; a < m->resumeCount; a++) {
+        if(m->resume[a].pixel >= 0) m->resume[count++] = m->resume[a];
+    }
+    m->resumeCount = count;
+    m->resumeIterations = m->iterations;
+
+    mirrorRows(m);
+    addMirroredStats(m);
+
+    antiAliasImage(m, numthreads, split);
+}
+
+/**
+ * @brief Calculates a row of a pass of a progressive render, between two columns. Every pixel of the row at a multiple of step is iterated and fills the step*step block below and to the right of it. The pixels that were already iterated by the previous pass, at multiples of 2*step in both directions, are skipped, unless this is the first pass.
+ * @param m The settings of the visualization.
+ * @param kernel The kernel of the visualization.
+ * @param row The row, a multiple of step.
+ * @param from The first column, a multiple of 2*step.
+ * @param to The column after the last one, the blocks are cut there.
+ * @param step The block size of the pass.
+ * @param firstPass If this is the first pass.
+ * @param ox A buffer for the positions, at least (to - from + step - 1) / step values.
+ * @param oy A buffer for the positions, as large as ox.
+ * @param cells A buffer for the results, as large as ox.
+ * @param stats Iteration counters of the calling job.
+ * @return The number of pixels iterated.
+ */
+int calculateBlockRow(mandelData * m, listKernel kernel, int row, int from, int to, int step, bool firstPass, double * ox, double * oy, brotStruct * cells, mandelStats * stats)
+{
+    bool skipEven = !firstPass && row % (2 * step) == 0;
+    int count = 0;
+
+    for(int x = from; x < to; x += step) {
+        if(skipEven && x % (2 * step) == 0) continue;
+        ox[count] = (double)x / (double)m->width * m->location.w;
+        oy[count] = (double)row / (double)m->height * m->location.h;
+        count++;
+    }
+
+    if(count > 0) kernel(m, ox, oy, count, m->interiorDetection, cells, stats);
+
+    int a = 0;
+    for(int x = from; x < to; x += step) {
+        if(skipEven && x % (2 * step) == 0) continue;
+
+        unsigned int color = colorBrot(cells[a], m);
+        for(int y = row; y < row + step && y < m->height; y++) {
+            for(int bx = x; bx < x + step && bx < to; bx++) {
+                m->image[pixelOffset(m, bx, y)] = color;
+                m->counts[pixelOffset(m, bx, y)] = cells[a].n;
+            }
+        }
+        a++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Calculates a row of a pass of a realtime frame with calculateBlockRow.
+ * @param w The worker.
+ * @param row The row, a multiple of step.
+ * @param step The block size of the pass.
+ */
+void calculateRealtimeRow(realtimeWorker * w, int row, int step)
+{
+    mandelData * m = w->r->m;
+    calculateBlockRow(m, w->r->kernel, row, 0, m->width, step, step == REALTIME_FIRST_STEP, w->ox, w->oy, w->cells, &w->stats);
+}
+
+/**
+ * @brief Checks if anything that changes the image of a realtime renderer has changed since its passes started: the view, the iteration cap, the formula and its power, the julia seed, the render mode, the interior detection or the colors of the palette.
+ * @param r The renderer, locked by the caller.
+ * @return true if the passes must start over.
+ */
+bool realtimeChanged(mandelRealtime * r)
+{
+    mandelData * m = r->m;
+    return memcmp(&r->location, &m->location, sizeof(rectangle)) != 0 || r->iterations != m->iterations || r->formula != m->formula || r->power != m->power || r->juliaX != m->juliaX || r->juliaY != m->juliaY || r->renderMode != m->renderMode || r->interiorDetection != m->interiorDetection || r->paletteChanges != color_getChanges(m->c);
+}
+
+/**
+ * @brief The long-lived job of a realtime worker. For every frame it takes rows of the current pass until the image is complete or the deadline has passed. A pass only starts when every row of the pass before is done, since its blocks would otherwise overwrite finer results. Decodes the void pointer.
+ * @param arg The realtimeWorker.
+ */
+void realtimeJob(void * arg)
+{
+    realtimeWorker * w = (realtimeWorker*) arg;
+    mandelRealtime * r = w->r;
+    int frame = 0;
+
+    pthread_mutex_lock(&r->lock);
+    for(;;) {
+        while(!r->quit && r->frame == frame) pthread_cond_wait(&r->start, &r->lock);
+        if(r->quit) break;
+        frame = r->frame;
+
+        while(r->step > 0 && monotonicSeconds() < r->deadline) {
+            if(r->nextRow >= r->m->height) {
+                if(r->inFlight > 0) {
+                    pthread_cond_wait(&r->passDone, &r->lock);
+                } else {
+                    r->step /= 2;
+                    r->nextRow = 0;
+                }
+                continue;
+            }
+
+            int row = r->nextRow, step = r->step;
+            r->nextRow += step;
+            r->inFlight++;
+            pthread_mutex_unlock(&r->lock);
+
+            calculateRealtimeRow(w, row, step);
+
+            pthread_mutex_lock(&r->lock);
+            r->inFlight--;
+            if(r->inFlight == 0 && r->nextRow >= r->m->height) pthread_cond_broadcast(&r->passDone);
+        }
+
+        r->working--;
+        if(r->working == 0) pthread_cond_signal(&r->done);
+    }
+    pthread_mutex_unlock(&r->lock);
+}
+
+/**
+ * @brief Checks if a block of a pass of a render with a time budget lies in the mirrored rows, so that it is copied by mirrorRows instead of calculated.
+ * @param m The settings of the visualization.
+ * @param row The first row of the block.
+ * @param step The block size of the pass.
+ * @return true if every row of the block is mirrored.
+ */
+bool isMirroredBlock(mandelData * m, int row, int step)
+{
+    int last = row + step - 1 < m->height ? row + step - 1 : m->height - 1;
+    return row >= m->mirrorStart && last <= m->mirrorEnd;
+}
+
+/**
+ * @brief The function called by the threadpool for a pass of a render with a time budget over a tile. The rows of blocks of the tile are calculated from the top with calculateBlockRow, BUDGET_CHUNK pixels at a time, until the tile is done or the deadline has passed. Decodes the void pointer.
+ * @param arg The budgetJobArg of the tile.
+ */
+void budgetJob(void * arg)
+{
+    budgetJobArg * jobArg = (budgetJobArg*) arg;
+    mandelData * m = jobArg->data;
+    pixelRect t = jobArg->tile;
+    int step = jobArg->step;
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+
+    double * ox = (double*) malloc(sizeof(double) * BUDGET_CHUNK);
+    double * oy = (double*) malloc(sizeof(double) * BUDGET_CHUNK);
+    brotStruct * cells = (brotStruct*) malloc(sizeof(brotStruct) * BUDGET_CHUNK);
+
+    //a row of single pixels at a high cap can take longer than the whole budget, so the deadline is checked within the rows
+    jobArg->samples = 0;
+    bool stopped = false;
+    for(int row = t.y; row < t.y + t.h && !stopped; row += step) {
+        if(isMirroredBlock(m, row, step)) continue;
+
+        for(int x = t.x; x < t.x + t.w; x += BUDGET_CHUNK * step) {
+            if(monotonicSeconds() >= jobArg->deadline) {
+                stopped = true;
+                break;
+            }
+
+            int to = x + BUDGET_CHUNK * step < t.x + t.w ? x + BUDGET_CHUNK * step : t.x + t.w;
+            jobArg->samples += calculateBlockRow(m, jobArg->kernel, row, x, to, step, step == BUDGET_FIRST_STEP, ox, oy, cells, &stats);
+        }
+    }
+    if(!stopped) jobArg->reached = step;
+
+    free(ox);
+    free(oy);
+    free(cells);
+    addStats(m, &stats);
+}
+
+/**
+ * @brief Runs a pass of a render with a time budget over every tile, each given to the thread that calculated it the last time, and copies the mirrored rows afterwards.
+ * @param m The settings of the visualization.
+ * @param p The threadpool.
+ * @param jobs The tiles.
+ * @param numTiles The number of tiles.
+ * @param step The block size of the pass.
+ * @param deadline The tiles start no chunk of a row after this time, from monotonicSeconds.
+ * @return true if every tile was done before the deadline.
+ */
+bool runBudgetPass(mandelData * m, struct threadpool * p, budgetJobArg * jobs, int numTiles, int step, double deadline)
+{
+    for(int a = 0; a < numTiles; a++) {
+        jobs[a].step = step;
+        jobs[a].deadline = deadline;
+        threadpool_enqueueTo(p, budgetJob, &jobs[a], m->tileThreads[jobs[a].key]);
+    }
+    threadpool_wait(p);
+    mirrorRowsInPool(m, p);
+
+    bool done = true;
+    for(int a = 0; a < numTiles; a++) {
+        done = done && jobs[a].reached == step;
+    }
+
+    return done;
+}
+
+/**
+ * @brief Plans the iteration cap of a render with a time budget before any of its pixels are calculated, from a timed probe of a grid of BUDGET_PROBE_SIZE*BUDGET_PROBE_SIZE points. The probe starts with a cap of AUTO_MIN_ITERATIONS, which is doubled up to the lowest cap the plan may choose while the next probe is estimated to take at most BUDGET_PROBE_SHARE of the time left. At a lower cap, the points of the probe that escaped cost their iteration-count and the ones that did not are taken to cost the whole cap. The cap is halved until every pixel is estimated to be calculated in the time left, but not below the cap divided by BUDGET_MAX_CAP_DIVISOR or AUTO_MIN_ITERATIONS.
+ * @param m The settings of the visualization, prepared for the render.
+ * @param kernel The kernel of the render.
+ * @param pixels The number of pixels to be calculated, without the mirrored ones.
+ * @param deadline The end of the render, from monotonicSeconds.
+ * @param stats Iteration counters for the probe.
+ * @return The cap.
+ */
+int planIterations(mandelData * m, listKernel kernel, long long pixels, double deadline, mandelStats * stats)
+{
+    int cap = m->iterations;
+    int lowest = cap / BUDGET_MAX_CAP_DIVISOR > AUTO_MIN_ITERATIONS ? cap / BUDGET_MAX_CAP_DIVISOR : AUTO_MIN_ITERATIONS;
+    if(lowest > cap) lowest = cap;
+
+    int count = BUDGET_PROBE_SIZE * BUDGET_PROBE_SIZE;
+    double * ox = (double*) malloc(sizeof(double) * count);
+    double * oy = (double*) malloc(sizeof(double) * count);
+    brotStruct * probe = (brotStruct*) malloc(sizeof(brotStruct) * count);
+
+    for(int a = 0; a < count; a++) {
+        ox[a] = ((double)(a % BUDGET_PROBE_SIZE) + 0.5) / (double)BUDGET_PROBE_SIZE * m->location.w;
+        oy[a] = ((double)(a / BUDGET_PROBE_SIZE) + 0.5) / (double)BUDGET_PROBE_SIZE * m->location.h;
+    }
+
+    //every doubling of the cap about doubles the time of the probe, so the probe takes about twice its share at most
+    int probeCap = AUTO_MIN_ITERATIONS < lowest ? AUTO_MIN_ITERATIONS : lowest;
+    double secondsPerIteration = 0.0;
+    for(;;) {
+        m->iterations = probeCap;
+        double start = monotonicSeconds();
+        long long before = stats->iterations;
+        kernel(m, ox, oy, count, m->interiorDetection, probe, stats);
+        double elapsed = monotonicSeconds() - start;
+        secondsPerIteration = elapsed / ((double)(stats->iterations - before) + (double)COST_PIXEL_OVERHEAD * (double)count + 1.0);
+
+        if(probeCap >= lowest || 2.0 * elapsed > BUDGET_PROBE_SHARE * (deadline - monotonicSeconds())) break;
+        probeCap = 2 * probeCap < lowest ? 2 * probeCap : lowest;
+    }
+    m->iterations = cap;
+
+    int planned = cap;
+    for(;;) {
+        double cost = (double)COST_PIXEL_OVERHEAD * (double)count;
+        for(int a = 0; a < count; a++) cost += (double)(probe[a].n < probeCap ? probe[a].n : planned);
+
+        double rest = secondsPerIteration * cost * (double)pixels / (double)count;
+        if(rest <= deadline - monotonicSeconds() || planned / 2 < lowest) break;
+        planned /= 2;
+    }
+
+    free(ox);
+    free(oy);
+    free(probe);
+
+    return planned;
+}
+
+/**
+ * @brief Gets the block size a tile of a render with a time budget reached, together with the tiles its mirrored rows are copied from. Block sizes are compared as the passes are run, from BUDGET_FIRST_STEP down to 1, and 0 is below all of them.
+ * @param m The settings of the visualization.
+ * @param jobs The tiles.
+ * @param tileJobs The index in jobs of the tile with each key.
+ * @param a The index of the tile.
+ * @return The coarsest block size of the tile and the tiles its mirrored rows are copied from, 0 if any of them was not calculated at all.
+ */
+int reachedStep(mandelData * m, const budgetJobArg * jobs, const int * tileJobs, int a)
+{
+    pixelRect t = jobs[a].tile;
+    int step = jobs[a].reached;
+
+    int first = t.y > m->mirrorStart ? t.y : m->mirrorStart;
+    int last = t.y + t.h - 1 < m->mirrorEnd ? t.y + t.h - 1 : m->mirrorEnd;
+    if(first > last) return step;
+
+    //row y is copied from row axis - y, so the rows first to last are copied from the rows axis - last to axis - first
+    int columns = (m->width + TILE_SIZE - 1) / TILE_SIZE;
+    for(int r = (m->mirrorAxis - last) / TILE_SIZE; r <= (m->mirrorAxis - first) / TILE_SIZE; r++) {
+        int from = jobs[tileJobs[r * columns + t.x / TILE_SIZE]].reached;
+        if(from == 0 || step == 0) return 0;
+        if(from > step) step = from;
+    }
+
+    return step;
+}
+
+/**
+ * @brief Runs the anti-aliasing pass of a render with a time budget, with as many samples per pixel as are estimated to fit in the time left. Every sample of a pixel is estimated to cost its iteration-count plus COST_PIXEL_OVERHEAD, at the speed of the last pass.
+ * @param m The settings of the visualization, rendered at full resolution.
+ * @param numthreads The number of threads.
+ * @param split The square root of the number of jobs.
+ * @param deadline The end of the render, from monotonicSeconds.
+ * @param secondsPerIteration The time the last pass took per iteration, including COST_PIXEL_OVERHEAD for every pixel.
+ * @return The largest number of samples per pixel, or 1 if there was no time for the pass or it was stopped by the deadline.
+ */
+int antiAliasBudget(mandelData * m, int numthreads, int split, double deadline, double secondsPerIteration)
+{
+    int count = 0;
+    int * pixels = findAntiAliasPixels(m, &count);
+
+    //every round adds BROT_LANES samples to each pixel
+    double round = 0.0;
+    for(int a = 0; a < count; a++) {
+        round += (double)(m->counts[indexOffset(m, pixels[a])] + COST_PIXEL_OVERHEAD);
+    }
+    round *= BROT_LANES * secondsPerIteration;
+
+    int rounds = (m->antiAliasSamples - 1) / BROT_LANES;
+    double left = deadline - monotonicSeconds();
+    if(round > 0.0 && left < round * rounds) rounds = left > 0.0 ? (int)(left / round) : 0;
+
+    int samples = 1;
+    if(count == 0) {
+        samples = m->antiAliasSamples;
+    } else if(rounds > 0) {
+        int maxSamples = m->antiAliasSamples;
+        m->antiAliasSamples = 1 + rounds * BROT_LANES;
+        if(antiAliasList(m, numthreads, split, pixels, count, deadline)) samples = m->antiAliasSamples;
+        m->antiAliasSamples = maxSamples;
+        mirrorRows(m);
+    }
+
+    free(pixels);
+
+    return samples;
+}
+
+
+/**
+ * @brief Allocates a pixel buffer set to zeros. The pages are mapped to zeros and not given any memory until they are first written, so every page ends up on the NUMA node of the thread that renders it first, instead of on the node of the thread that creates the buffer. The buffer is aligned to huge pages and transparent huge pages are asked for, which saves most of the page faults and TLB misses of large images.
+ * @param bytes The size of the buffer.
+ * @return The buffer, freed with freePixels.
+ */
+void * allocatePixels(size_t bytes)
+{
+#ifdef MAP_ANONYMOUS
+    size_t size = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+    //the mapping is made one huge page larger, and the parts before and after the aligned buffer are given back
+    char * mapping = (char*) mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mapping == MAP_FAILED) return NULL;
+
+    char * buffer = (char*) (((size_t)mapping + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+    if(buffer > mapping) munmap(mapping, buffer - mapping);
+    if(mapping + HUGE_PAGE_SIZE > buffer) munmap(buffer + size, mapping + HUGE_PAGE_SIZE - buffer);
+
+#ifdef MADV_HUGEPAGE
+    madvise(buffer, size, MADV_HUGEPAGE);
+#endif
+
+    return buffer;
+#else
+    return calloc(bytes, 1);
+#endif
+}
+
+/**
+ * @brief Frees a pixel buffer allocated by allocatePixels.
+ * @param buffer The buffer.
+ * @param bytes The size of the buffer.
+ */
+void freePixels(void * buffer, size_t bytes)
+{
+#ifdef MAP_ANONYMOUS
+    munmap(buffer, (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+#else
+    free(buffer);
+#endif
+}
+
+/**
+ * @brief Gets the resolution class of an image size, the smallest k such that the image has at most 4^k pixels. A class holds the images of about the same number of pixels as a square of side 2^k.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @return The class.
+ */
+int resolutionClass(int width, int height)
+{
+    long long pixels = (long long)width * height;
+    int k = 0;
+    while((1LL << (2 * k)) < pixels) k++;
+
+    return k;
+}
+
+/**
+ * @brief Identifies the host in a profile file, by its name and its number of processors, so that a profile is tuned again if either changes.
+ * @param name Set to the name of the host.
+ * @param size The size of name.
+ * @param cores Set to the number of processors online.
+ */
+void hostIdentity(char * name, size_t size, int * cores)
+{
+    if(gethostname(name, size) != 0) name[0] = '\0';
+    name[size - 1] = '\0';
+    if(name[0] == '\0') snprintf(name, size, "unknown");
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    *cores = online > 0 ? (int)online : 1;
+}
+
+/**
+ * @brief Reads the settings of a host and a resolution class from a profile file. Every line of the file holds the host name, its number of processors, the resolution class, the number of threads, the jobs per thread and the split, separated by spaces. Other lines are ignored.
+ * @param path The profile file.
+ * @param name The name of the host.
+ * @param cores The number of processors of the host.
+ * @param resolution The resolution class.
+ * @param p Set to the settings.
+ * @return true if the file has settings for the host and the class.
+ */
+bool readProfile(const char * path, const char * name, int cores, int resolution, renderProfile * p)
+{
+    FILE * f = fopen(path, "r");
+    if(f == NULL) return false;
+
+    char line[PROFILE_LINE_LENGTH], host[PROFILE_LINE_LENGTH];
+    int lineCores, lineClass;
+    renderProfile entry;
+    bool found = false;
+
+    while(!found && fgets(line, sizeof(line), f) != NULL) {
+        if(sscanf(line, "%255s %d %d %d %d %d", host, &lineCores, &lineClass, &entry.threads, &entry.jobsPerThread, &entry.split) != 6) continue;
+        found = strcmp(host, name) == 0 && lineCores == cores && lineClass == resolution && entry.threads > 0 && entry.jobsPerThread > 0 && entry.split > 0;
+    }
+    fclose(f);
+
+    if(found) *p = entry;
+    return found;
+}
+
+/**
+ * @brief Writes the settings of a host and a resolution class to a profile file, replacing the ones it had and keeping the other lines.
+ * @param path The profile file.
+ * @param name The name of the host.
+ * @param cores The number of processors of the host.
+ * @param resolution The resolution class.
+ * @param p The settings.
+ * @return true if the file could be written.
+ */
+bool writeProfile(const char * path, const char * name, int cores, int resolution, const renderProfile * p)
+{
+    char * kept = NULL;
+    size_t keptLength = 0;
 
-    m->location = location;
+    FILE * f = fopen(path, "r");
+    if(f != NULL) {
+        char line[PROFILE_LINE_LENGTH], host[PROFILE_LINE_LENGTH];
+        int lineCores, lineClass;
+
+        while(fgets(line, sizeof(line), f) != NULL) {
+            if(sscanf(line, "%255s %d %d", host, &lineCores, &lineClass) == 3 && strcmp(host, name) == 0 && lineCores == cores && lineClass == resolution) continue;
+
+            size_t length = strlen(line);
+            kept = (char*) realloc(kept, keptLength + length);
+            memcpy(kept + keptLength, line, length);
+            keptLength += length;
+        }
+        fclose(f);
+    }
+
+    //the new file is written next to the old one and renamed over it, so that a render reading the profile meanwhile never sees it half written
+    char * temporary = (char*) malloc(strlen(path) + 32);
+    sprintf(temporary, "%s.%ld.tmp", path, (long)getpid());
+
+    f = fopen(temporary, "w");
+    if(f == NULL) {
+        free(kept);
+        free(temporary);
+        return false;
+    }
+
+    if(keptLength == 0) fprintf(f, "# host processors class threads jobs-per-thread split\n");
+    fwrite(kept, 1, keptLength, f);
+    fprintf(f, "%s %d %d %d %d %d\n", name, cores, resolution, p->threads, p->jobsPerThread, p->split);
+    bool written = !ferror(f);
+    written = fclose(f) == 0 && written;
+    written = written && rename(temporary, path) == 0;
+    if(!written) remove(temporary);
+
+    free(kept);
+    free(temporary);
+
+    return written;
+}
+
+/**
+ * @brief Times the renders of the calibration scenes with some settings. The first render of a scene with a number of threads is not timed, since it also creates the threads and writes the pages of the image for the first time, which the later renders of a visualization do not.
+ * @param scenes The scenes.
+ * @param count The number of scenes.
+ * @param p The settings.
+ * @return The sum over the scenes of their fastest render, in seconds.
+ */
+double timeProfile(mandelData ** scenes, int count, renderProfile p)
+{
+    double total = 0.0;
+
+    for(int a = 0; a < count; a++) {
+        scenes[a]->profile = p;
+        scenes[a]->profileLoaded = true;
+        if(scenes[a]->poolThreads != p.threads) mandel_render(scenes[a], MANDEL_AUTO, MANDEL_AUTO);
+
+        double best = DBL_MAX;
+        for(int r = 0; r < TUNE_REPEATS; r++) {
+            double start = monotonicSeconds();
+            mandel_render(scenes[a], MANDEL_AUTO, MANDEL_AUTO);
+            double elapsed = monotonicSeconds() - start;
+            if(elapsed < best) best = elapsed;
+        }
+        total += best;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Times some settings and keeps them if they are the fastest so far.
+ * @param scenes The scenes.
+ * @param count The number of scenes.
+ * @param p The settings.
+ * @param best The fastest settings so far, updated by the call.
+ * @param bestTime The time of the fastest settings so far, updated by the call.
+ */
+void tryProfile(mandelData ** scenes, int count, renderProfile p, renderProfile * best, double * bestTime)
+{
+    double time = timeProfile(scenes, count, p);
+    if(time < *bestTime) {
+        *best = p;
+        *bestTime = time;
+    }
+}
+
+/**
+ * @brief Calibrates the settings of a resolution class on this host, by timing renders of a view of the whole set and of a view on its border, which has far more expensive pixels. The scenes are rendered at the size of the class, up to TUNE_MAX_SIDE, so that they have as many tiles as the images of the class, and their iteration caps are lowered with the number of pixels so that the calibration of a large class does not take much longer. The number of threads is tuned first, since it matters the most, and then the jobs per thread and the split at that number.
+ * @param resolution The resolution class.
+ * @param cores The number of processors of the host.
+ * @return The fastest settings.
+ */
+renderProfile calibrateProfile(int resolution, int cores)
+{
+    //the center, the width and the iteration cap of the scenes
+    const double scenes[][4] = {
+        {-0.5, 0.0, 3.0, 256},
+        {-0.7436, 0.1318, 0.02, 512}
+    };
+    int count = sizeof(scenes) / sizeof(scenes[0]);
+
+    int side = resolution < 30 ? 1 << resolution : TUNE_MAX_SIDE;
+    if(side > TUNE_MAX_SIDE) side = TUNE_MAX_SIDE;
+    double scale = (double)TUNE_SCENE_PIXELS / ((double)side * side);
+    if(scale > 1.0) scale = 1.0;
+
+    colorPalette * c = color_createPalette(2);
+    color_setColor(c, 0, 0, 0, 0);
+    color_setColor(c, 255, 255, 255, 1);
+
+    mandelData * m[sizeof(scenes) / sizeof(scenes[0])];
+    for(int a = 0; a < count; a++) {
+        double x = scenes[a][0], y = scenes[a][1], w = scenes[a][2];
+        int iterations = (int)(scenes[a][3] * scale);
+        if(iterations < TUNE_MIN_ITERATIONS) iterations = TUNE_MIN_ITERATIONS;
+        m[a] = mandel_createMandelData(iterations, x - w / 2.0, y + w / 2.0, x + w / 2.0, y - w / 2.0, side, side, c);
+    }
+
+    renderProfile best = {1, JOBS_PER_THREAD, TUNE_DEFAULT_SPLIT};
+    double bestTime = timeProfile(m, count, best);
+
+    for(int threads = 2; threads / 2 < cores; threads *= 2) {
+        renderProfile p = best;
+        p.threads = threads < cores ? threads : cores;
+        tryProfile(m, count, p, &best, &bestTime);
+    }
+
+    const int jobsPerThread[] = {4, 64};
+    for(int a = 0; a < 2; a++) {
+        renderProfile p = best;
+        p.jobsPerThread = jobsPerThread[a];
+        tryProfile(m, count, p, &best, &bestTime);
+    }
+
+    const int splits[] = {4, 16};
+    for(int a = 0; a < 2; a++) {
+        renderProfile p = best;
+        p.split = splits[a];
+        tryProfile(m, count, p, &best, &bestTime);
+    }
+
+    for(int a = 0; a < count; a++) mandel_destroyMandelData(m[a]);
+    color_destroyPalette(c);
+
+    return best;
+}
+
+/**
+ * @brief Gets the settings used for MANDEL_AUTO by a visualization. They are read from its profile file the first time. If the file has none for this host and the resolution class of the image, every processor gets a thread and the other settings are the defaults; the calibration is left to mandel_tune, so that a render never takes seconds longer or writes a file unasked.
+ * @param m The settings of the visualization.
+ * @return The settings.
+ */
+const renderProfile * loadProfile(mandelData * m)
+{
+    if(m->profileLoaded) return &m->profile;
+
+    char name[PROFILE_LINE_LENGTH];
+    int cores;
+    hostIdentity(name, sizeof(name), &cores);
+
+    int resolution = resolutionClass(m->width, m->height);
+    const char * path = m->profilePath != NULL ? m->profilePath : MANDEL_PROFILE_FILE;
+    if(!readProfile(path, name, cores, resolution, &m->profile)) {
+        m->profile = (renderProfile) {
+            cores, JOBS_PER_THREAD, TUNE_DEFAULT_SPLIT
+        };
+    }
+    m->profileLoaded = true;
+
+    return &m->profile;
+}
+
+/**
+ * @brief Prepares a visualization to be rendered from the start. The precision and the mirrored rows are chosen, the pixels saved for resuming are dropped, the iteration cap is chosen if it is automatic, the reference orbit is calculated if perturbation is used, and the statistics are reset.
+ * @param m The settings of the visualization.
+ */
+void prepareRender(mandelData * m)
+{
+    m->precision = choosePrecision(m);
+    m->fixedBits = chooseFixedBits(m);
+    findMirrorRows(m);
+
+    free(m->resume);
+    m->resume = NULL;
+    m->resumeCount = 0;
+    m->resumeIterations = 0;
+
+    //every job perturbs the same reference orbit, calculated for the center of the visualization
+    //the probe of the automatic iteration cap calculates it as well, long enough for any cap it may choose
+    mandelStats probeStats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+    if(m->reference != NULL) perturb_destroyOrbit(m->reference);
+    m->reference = NULL;
+    if(m->autoIterations) chooseIterations(m, &probeStats);
+    if(m->precision == MANDEL_PRECISION_PERTURBATION && m->reference == NULL) {
+        m->reference = createReference(m, m->location.w / 2.0, m->location.h / 2.0);
+    }
+
+    pthread_mutex_lock(&m->statsLock);
+    m->stats = (mandelStats) {
+        0, 0, 0, 0, m->reference != NULL, 0, 0, 0, 0, 0, m->precision, m->fixedBits
+    };
+    pthread_mutex_unlock(&m->statsLock);
+    addStats(m, &probeStats);
+}
+
+
+// ---public functions---
+
+mandelData * mandel_createMandelData(int iterations, double xFrom, double yFrom, double xTo, double yTo, int imageWidth, int imageHeight, colorPalette * c)
+{
+    mandelData * m = (mandelData*) malloc(sizeof(mandelData));
+    m->iterations = iterations;
+    mandel_setLocation(m, xFrom, yFrom, xTo, yTo);
+    m->fixedBits = 0;
     m->width = imageWidth;
     m->height = imageHeight;
 
     m->c = c;
 
-    //init the image and set every pixel to 0
-    m->image = (unsigned int *) malloc(sizeof(int) * imageWidth * imageHeight);
-    for(int a = 0; a < imageWidth * imageHeight; a++) m->image[a] = 0;
+    m->interiorDetection = false;
+    m->perturbation = true;
+    m->seriesApproximation = true;
+    m->rectangleChecking = false;
+    m->autoIterations = false;
+    m->formula = MANDEL_FORMULA_MANDELBROT;
+    m->power = 2;
+    m->juliaX = 0.0;
+    m->juliaY = 0.0;
+    m->antiAliasSamples = 9;
+    m->renderMode = MANDEL_RENDER_ESCAPE_TIME;
+    m->buddhabrotSamples = 4;
+    m->mirrorAxis = 0;
+    m->mirrorStart = 1;
+    m->mirrorEnd = 0;
+    m->resume = NULL;
+    m->resumeCount = 0;
+    m->resumeIterations = 0;
+    m->aliasedPixels = NULL;
+    m->aliasedColors = NULL;
+    m->aliasedCount = 0;
+    m->reference = NULL;
+    m->precision = MANDEL_PRECISION_DOUBLE;
+    m->stats = (mandelStats) {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits
+    };
+    pthread_mutex_init(&m->statsLock, NULL);
+
+    //the image starts with every pixel 0, without the pages being written here
+    m->tiledLayout = false;
+    m->image = (unsigned int *) allocatePixels(sizeof(int) * pixelStorage(m));
+    m->counts = (int *) allocatePixels(sizeof(int) * pixelStorage(m));
+
+    m->pool = NULL;
+    m->poolThreads = 0;
+    m->pinThreads = false;
+    m->tileThreads = (int *) malloc(sizeof(int) * ((imageWidth + TILE_SIZE - 1) / TILE_SIZE) * ((imageHeight + TILE_SIZE - 1) / TILE_SIZE));
+
+    m->profilePath = NULL;
+    m->profileLoaded = false;
+    m->quality = NULL;
+    m->qualityCount = 0;
 
     return m;
 }
 
 unsigned int * mandel_render(mandelData * m, int numthreads, int split)
 {
-    rectangle ** subRects = divideRectangle(m->location, split);
+    m->qualityCount = 0;
+
+    int jobsPerThread = JOBS_PER_THREAD;
+    if(numthreads == MANDEL_AUTO || split == MANDEL_AUTO) {
+        const renderProfile * p = loadProfile(m);
+        if(numthreads == MANDEL_AUTO) {
+            numthreads = p->threads;
+            jobsPerThread = p->jobsPerThread;
+        }
+        if(split == MANDEL_AUTO) split = p->split;
+    }
 
-    struct threadpool * p = threadpool_create(numthreads);
+    if(m->renderMode == MANDEL_RENDER_BUDDHABROT) {
+        free(m->resume);
+        m->resume = NULL;
+        m->resumeCount = 0;
+        m->resumeIterations = 0;
+        m->mirrorStart = 1;
+        m->mirrorEnd = 0;
 
-    //put jobs into the threadpool
-    for (int x = 0; x < split; x++) {
-        for(int y = 0; y < split; y++) {
-            mandelJobArg * jobArg = (mandelJobArg*) malloc(sizeof(mandelJobArg));
-            jobArg->calcLocation = subRects[x][y];
-            jobArg->data = m;
-            threadpool_enqueue(p, mandelJob, jobArg);
-        }
+        renderBuddhabrot(m, numthreads);
+        return m->image;
+    }
+
+    //when only the iteration cap has been raised, the pixels that reached the old cap are continued and the rest is kept
+    if(m->resumeIterations > 0 && m->iterations > m->resumeIterations) {
+        resumeRender(m, numthreads, split);
+        return m->image;
+    }
+
+    prepareRender(m);
+
+    int numTiles = 0;
+    pixelRect * tiles = divideImage(m, &numTiles);
+    mandelJobArg ** jobs = (mandelJobArg**) malloc(sizeof(mandelJobArg*) * numTiles);
+
+    struct threadpool * p = renderPool(m, numthreads);
+
+    //the costs of the tiles are estimated first, since the target of the jobs depends on the total
+    for(int a = 0; a < numTiles; a++) {
+        jobs[a] = (mandelJobArg*) malloc(sizeof(mandelJobArg));
+        jobs[a]->tile = tiles[a];
+        jobs[a]->key = tiles[a].y / TILE_SIZE * ((m->width + TILE_SIZE - 1) / TILE_SIZE) + tiles[a].x / TILE_SIZE;
+        jobs[a]->merged = NULL;
+        jobs[a]->pool = p;
+        jobs[a]->data = m;
+        threadpool_enqueue(p, probeJob, jobs[a]);
+    }
+    threadpool_wait(p);
+
+    double total = 0.0;
+    for(int a = 0; a < numTiles; a++) {
+        total += jobs[a]->cost;
+    }
+    int numJobs = mergeTiles(m, jobs, numTiles, total / (double)(numthreads * jobsPerThread));
+
+    //put jobs into the threadpool, the most expensive first so that none of them is started last
+    //every tile is given to the thread that calculated it the last time, which may still have its part of the image in its caches
+    qsort(jobs, numJobs, sizeof(mandelJobArg*), compareJobCosts);
+    for(int a = 0; a < numJobs; a++) {
+        threadpool_enqueueTo(p, mandelJob, jobs[a], m->tileThreads[jobs[a]->key]);
     }
 
+    //the anti-aliasing pass needs every pixel and its neighbors, so all jobs must be done, also the ones added by other jobs
+    threadpool_wait(p);
+    mirrorRowsInPool(m, p);
+    addMirroredStats(m);
+
+    sortResumePoints(m);
+    m->resumeIterations = canResume(m) ? m->iterations : 0;
+
+    antiAliasImage(m, numthreads, split);
+
     //free memory
-    threadpool_destroy(p);
+    free(tiles);
+    free(jobs);
 
-    for(int a = 0; a < split; a++) {
-        free(subRects[a]);
+    return m->image;
+}
+
+unsigned int * mandel_renderBudget(mandelData * m, int numthreads, int split, double budget)
+{
+    double deadline = monotonicSeconds() + budget;
+
+    if(m->renderMode == MANDEL_RENDER_BUDDHABROT) return mandel_render(m, numthreads, split);
+    if(numthreads == MANDEL_AUTO) numthreads = loadProfile(m)->threads;
+    if(split == MANDEL_AUTO) split = loadProfile(m)->split;
+
+    prepareRender(m);
+    int requested = m->iterations;
+
+    int numTiles = 0;
+    pixelRect * tiles = divideImage(m, &numTiles);
+    budgetJobArg * jobs = (budgetJobArg*) malloc(sizeof(budgetJobArg) * numTiles);
+    int * tileJobs = (int*) malloc(sizeof(int) * numTiles);
+    for(int a = 0; a < numTiles; a++) {
+        jobs[a].data = m;
+        jobs[a].tile = tiles[a];
+        jobs[a].key = tiles[a].y / TILE_SIZE * ((m->width + TILE_SIZE - 1) / TILE_SIZE) + tiles[a].x / TILE_SIZE;
+        jobs[a].kernel = chooseKernel(m);
+        jobs[a].reached = 0;
+        tileJobs[jobs[a].key] = a;
     }
-    free(subRects);
+
+    long long pixels = (long long)m->width * m->height;
+    if(m->mirrorStart <= m->mirrorEnd) pixels -= (long long)(m->mirrorEnd - m->mirrorStart + 1) * m->width;
+
+    //the cap is planned before the first pass, which would otherwise be the one pass that can take far longer than the budget
+    mandelStats probeStats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+    m->iterations = planIterations(m, jobs[0].kernel, pixels, deadline, &probeStats);
+    addStats(m, &probeStats);
+    struct threadpool * p = renderPool(m, numthreads);
+
+    //every pass refines the whole image before the next one starts, so that the image stays even when the deadline stops a pass
+    //the anti-aliasing pass is planned from what the last pass cost
+    double secondsPerIteration = 0.0;
+    bool finished = true;
+    for(int step = BUDGET_FIRST_STEP; step >= 1 && finished; step /= 2) {
+        double start = monotonicSeconds();
+        long long before = mandel_getStats(m).iterations;
+        finished = start < deadline && runBudgetPass(m, p, jobs, numTiles, step, deadline);
+        double elapsed = monotonicSeconds() - start;
+
+        long long samples = 0;
+        for(int a = 0; a < numTiles; a++) samples += jobs[a].samples;
+        long long iterations = mandel_getStats(m).iterations - before;
+        secondsPerIteration = elapsed / ((double)iterations + (double)COST_PIXEL_OVERHEAD * (double)samples + 1.0);
+    }
+    addMirroredStats(m);
+
+    //the distance render mode is already smooth with one sample per pixel
+    int aaSamples = 1;
+    if(finished && m->antiAliasSamples > 1 && m->renderMode == MANDEL_RENDER_ESCAPE_TIME) aaSamples = antiAliasBudget(m, numthreads, split, deadline, secondsPerIteration);
+
+    free(m->quality);
+    m->quality = (mandelRegionQuality*) malloc(sizeof(mandelRegionQuality) * numTiles);
+    for(int a = 0; a < numTiles; a++) {
+        //the mirrored rows of a tile are only as good as the rows they are copied from
+        int step = reachedStep(m, jobs, tileJobs, a);
+        m->quality[a] = (mandelRegionQuality) {
+            tiles[a].x, tiles[a].y, tiles[a].w, tiles[a].h, step, step == 1 ? aaSamples : 1, m->iterations
+        };
+    }
+    m->qualityCount = numTiles;
+
+    //the cap lowered by the plan is only for this render
+    m->iterations = requested;
+
+    free(tiles);
+    free(jobs);
+    free(tileJobs);
 
     return m->image;
 }
 
+const mandelRegionQuality * mandel_getQuality(mandelData * m, int * count)
+{
+    *count = m->qualityCount;
+    return m->quality;
+}
+
 renderThread * mandel_renderUnfinished(mandelData * m, int numthreads, int split)
 {
     struct threadArgs * t = (struct threadArgs*) malloc(sizeof(struct threadArgs));
@@ -360,8 +3543,320 @@ renderThread * mandel_renderUnfinished(mandelData * m, int numthreads, int split
     return newThread;
 }
 
+mandelRealtime * mandel_createRealtime(mandelData * m, int numthreads)
+{
+    if(numthreads == MANDEL_AUTO) numthreads = loadProfile(m)->threads;
+
+    mandelRealtime * r = (mandelRealtime*) malloc(sizeof(mandelRealtime));
+    r->m = m;
+    r->numthreads = numthreads;
+    r->frame = 0;
+    r->working = 0;
+    r->quit = false;
+    r->deadline = 0.0;
+    r->step = 0;
+    r->nextRow = 0;
+    r->inFlight = 0;
+    r->kernel = NULL;
+    r->iterations = -1;
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->start, NULL);
+    pthread_cond_init(&r->done, NULL);
+    pthread_cond_init(&r->passDone, NULL);
+
+    r->workers = (realtimeWorker*) malloc(sizeof(realtimeWorker) * numthreads);
+    r->pool = threadpool_create(numthreads);
+    for(int a = 0; a < numthreads; a++) {
+        realtimeWorker * w = &r->workers[a];
+        w->r = r;
+        w->ox = (double*) malloc(sizeof(double) * m->width);
+        w->oy = (double*) malloc(sizeof(double) * m->width);
+        w->cells = (brotStruct*) malloc(sizeof(brotStruct) * m->width);
+        threadpool_enqueue(r->pool, realtimeJob, w);
+    }
+
+    return r;
+}
+
+unsigned int * mandel_renderFrame(mandelRealtime * r, double budget)
+{
+    mandelData * m = r->m;
+
+    pthread_mutex_lock(&r->lock);
+
+    //the passes start over when anything that changes the image has changed
+    if(realtimeChanged(r)) {
+        r->location = m->location;
+        r->iterations = m->iterations;
+        r->formula = m->formula;
+        r->power = m->power;
+        r->juliaX = m->juliaX;
+        r->juliaY = m->juliaY;
+        r->renderMode = m->renderMode;
+        r->interiorDetection = m->interiorDetection;
+        r->paletteChanges = color_getChanges(m->c);
+
+        m->precision = choosePrecision(m);
+        if(m->precision > MANDEL_PRECISION_DOUBLE) m->precision = MANDEL_PRECISION_DOUBLE;
+        m->fixedBits = 0;
+        m->resumeIterations = 0;
+        r->kernel = chooseKernel(m);
+        r->step = REALTIME_FIRST_STEP;
+        r->nextRow = 0;
+
+        pthread_mutex_lock(&m->statsLock);
+        m->stats = (mandelStats) {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits
+        };
+        pthread_mutex_unlock(&m->statsLock);
+    }
+
+    if(r->step > 0) {
+        for(int a = 0; a < r->numthreads; a++) {
+            r->workers[a].stats = (mandelStats) {
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits
+            };
+        }
+
+        r->deadline = monotonicSeconds() + budget;
+        r->working = r->numthreads;
+        r->frame++;
+        pthread_cond_broadcast(&r->start);
+        while(r->working > 0) pthread_cond_wait(&r->done, &r->lock);
+
+        for(int a = 0; a < r->numthreads; a++) addStats(m, &r->workers[a].stats);
+    }
+
+    pthread_mutex_unlock(&r->lock);
+
+    return m->image;
+}
+
+bool mandel_isFrameComplete(mandelRealtime * r)
+{
+    pthread_mutex_lock(&r->lock);
+    bool complete = r->step == 0 && !realtimeChanged(r);
+    pthread_mutex_unlock(&r->lock);
+
+    return complete;
+}
+
+void mandel_destroyRealtime(mandelRealtime * r)
+{
+    pthread_mutex_lock(&r->lock);
+    r->quit = true;
+    pthread_cond_broadcast(&r->start);
+    pthread_mutex_unlock(&r->lock);
+    threadpool_destroy(r->pool);
+
+    for(int a = 0; a < r->numthreads; a++) {
+        free(r->workers[a].ox);
+        free(r->workers[a].oy);
+        free(r->workers[a].cells);
+    }
+    free(r->workers);
+    pthread_mutex_destroy(&r->lock);
+    pthread_cond_destroy(&r->start);
+    pthread_cond_destroy(&r->done);
+    pthread_cond_destroy(&r->passDone);
+    free(r);
+}
+
+void mandel_setLocation(mandelData * m, double xFrom, double yFrom, double xTo, double yTo)
+{
+    m->location.x = xFrom;
+    m->location.y = yFrom;
+    m->location.w = xTo - xFrom;
+    m->location.h = yTo - yFrom;
+    m->originX = dd_fromDouble(xFrom);
+    m->originY = dd_fromDouble(yFrom);
+    m->centerX = fixed_fromDoubleDouble(dd_add(m->originX, dd_fromDouble(m->location.w / 2.0)));
+    m->centerY = fixed_fromDoubleDouble(dd_add(m->originY, dd_fromDouble(m->location.h / 2.0)));
+    m->resumeIterations = 0;
+}
+
+void mandel_setCenter(mandelData * m, doubleDouble x, doubleDouble y)
+{
+    m->originX = dd_sub(x, dd_fromDouble(m->location.w / 2.0));
+    m->originY = dd_sub(y, dd_fromDouble(m->location.h / 2.0));
+    m->location.x = dd_toDouble(m->originX);
+    m->location.y = dd_toDouble(m->originY);
+    m->centerX = fixed_fromDoubleDouble(x);
+    m->centerY = fixed_fromDoubleDouble(y);
+    m->resumeIterations = 0;
+}
+
+void mandel_setCenterString(mandelData * m, const char * x, const char * y)
+{
+    mandel_setCenter(m, dd_fromString(x), dd_fromString(y));
+
+    //the string may have more digits than a doubleDouble, they are kept for the reference orbit
+    m->centerX = fixed_fromString(x);
+    m->centerY = fixed_fromString(y);
+}
+
+void mandel_setInteriorDetection(mandelData * m, bool enabled)
+{
+    m->interiorDetection = enabled;
+    m->resumeIterations = 0;
+}
+
+void mandel_setPerturbation(mandelData * m, bool enabled)
+{
+    m->perturbation = enabled;
+    m->resumeIterations = 0;
+}
+
+void mandel_setSeriesApproximation(mandelData * m, bool enabled)
+{
+    m->seriesApproximation = enabled;
+    m->resumeIterations = 0;
+}
+
+void mandel_setRectangleChecking(mandelData * m, bool enabled)
+{
+    m->rectangleChecking = enabled;
+    m->resumeIterations = 0;
+}
+
+void mandel_setAntiAliasing(mandelData * m, int maxSamples)
+{
+    m->antiAliasSamples = maxSamples;
+    m->resumeIterations = 0;
+}
+
+void mandel_setRenderMode(mandelData * m, mandelRenderMode mode)
+{
+    m->renderMode = mode;
+    m->resumeIterations = 0;
+}
+
+void mandel_setBuddhabrotSamples(mandelData * m, int samples)
+{
+    m->buddhabrotSamples = samples;
+}
+
+void mandel_setTiledLayout(mandelData * m, bool enabled)
+{
+    if(m->tiledLayout == enabled) return;
+
+    freePixels(m->image, sizeof(int) * pixelStorage(m));
+    freePixels(m->counts, sizeof(int) * pixelStorage(m));
+    m->tiledLayout = enabled;
+    m->image = (unsigned int *) allocatePixels(sizeof(int) * pixelStorage(m));
+    m->counts = (int *) allocatePixels(sizeof(int) * pixelStorage(m));
+
+    //the pixels of the last render are gone, so there is nothing to resume
+    m->resumeIterations = 0;
+    m->aliasedCount = 0;
+    m->qualityCount = 0;
+}
+
+void mandel_setThreadPinning(mandelData * m, bool enabled)
+{
+    if(m->pinThreads == enabled) return;
+
+    //the threads are pinned when the pool is created, so the pool is created again by the next render
+    if(m->pool != NULL) threadpool_destroy(m->pool);
+    m->pool = NULL;
+    m->poolThreads = 0;
+    m->pinThreads = enabled;
+}
+
+void mandel_exportImage(mandelData * m, unsigned int * out)
+{
+    if(!m->tiledLayout) {
+        memcpy(out, m->image, sizeof(unsigned int) * m->width * m->height);
+        return;
+    }
+
+    //every row of a block is one run of memory, copied as a whole
+    for(int y = 0; y < m->height; y++) {
+        for(int x = 0; x < m->width;) {
+            int run = pixelRun(m, x, m->width - x);
+            memcpy(&out[y * m->width + x], &m->image[pixelOffset(m, x, y)], sizeof(unsigned int) * run);
+            x += run;
+        }
+    }
+}
+
+void mandel_setProfile(mandelData * m, const char * path)
+{
+    free(m->profilePath);
+    m->profilePath = NULL;
+    if(path != NULL) {
+        m->profilePath = (char*) malloc(strlen(path) + 1);
+        strcpy(m->profilePath, path);
+    }
+    m->profileLoaded = false;
+}
+
+bool mandel_tune(const char * path, int width, int height)
+{
+    char name[PROFILE_LINE_LENGTH];
+    int cores;
+    hostIdentity(name, sizeof(name), &cores);
+
+    int resolution = resolutionClass(width, height);
+    renderProfile p = calibrateProfile(resolution, cores);
+
+    return writeProfile(path != NULL ? path : MANDEL_PROFILE_FILE, name, cores, resolution, &p);
+}
+
+void mandel_setIterations(mandelData * m, int iterations)
+{
+    m->iterations = iterations;
+}
+
+int mandel_getIterations(mandelData * m)
+{
+    return m->iterations;
+}
+
+void mandel_setAutoIterations(mandelData * m, bool enabled)
+{
+    m->autoIterations = enabled;
+    m->resumeIterations = 0;
+}
+
+void mandel_setFormula(mandelData * m, mandelFormula formula, int power)
+{
+    if(power < 2) power = 2;
+    if(power > MANDEL_MAX_POWER) power = MANDEL_MAX_POWER;
+
+    m->formula = formula;
+    m->power = power;
+    m->resumeIterations = 0;
+}
+
+void mandel_setJuliaSeed(mandelData * m, double x, double y)
+{
+    m->juliaX = x;
+    m->juliaY = y;
+    m->resumeIterations = 0;
+}
+
+mandelStats mandel_getStats(mandelData * m)
+{
+    pthread_mutex_lock(&m->statsLock);
+    mandelStats stats = m->stats;
+    pthread_mutex_unlock(&m->statsLock);
+
+    return stats;
+}
+
 void mandel_destroyMandelData(mandelData * m)
 {
-    free(m->image);
+    if(m->pool != NULL) threadpool_destroy(m->pool);
+    pthread_mutex_destroy(&m->statsLock);
+    if(m->reference != NULL) perturb_destroyOrbit(m->reference);
+    freePixels(m->image, sizeof(int) * pixelStorage(m));
+    freePixels(m->counts, sizeof(int) * pixelStorage(m));
+    free(m->resume);
+    free(m->aliasedPixels);
+    free(m->aliasedColors);
+    free(m->tileThreads);
+    free(m->profilePath);
+    free(m->quality);
     free(m);
 }
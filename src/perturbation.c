@@ -0,0 +1,265 @@
+/**
+ * @file perturbation.c
+ * @date 18/10 2026
+ * @brief Perturbation of a high precision reference orbit. A point c = C + dc has the orbit z = Z + e, where Z is the orbit of the reference and e follows e' = 2*Z*e + e*e + dc, which only needs double precision.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "../include/perturbation.h"
+
+//same as INTERIOR_EPSILON in mandelbrot.c
+#define PERTURB_INTERIOR_EPSILON 1e-12
+
+//the series is only trusted while its last term is at most this fraction of the term before
+#define SERIES_TERM_RATIO 1e-3
+
+//the coefficients are no longer calculated when |A| passes this, the higher terms would overflow soon after
+#define SERIES_LIMIT 1e100
+
+/**
+ * @brief Evaluates the series approximation of a point.
+ * @param t The coefficients.
+ * @param dcx x-offset of the point from the reference.
+ * @param dcy y-offset of the point from the reference.
+ * @param ex Set to the x-offset of the orbit from the reference.
+ * @param ey Set to the y-offset of the orbit from the reference.
+ * @param dx Set to the x-part of the derivative of the orbit with respect to the point.
+ * @param dy Set to the y-part of the derivative of the orbit with respect to the point.
+ */
+static inline void seriesAt(const seriesTerm * t, double dcx, double dcy, double * ex, double * ey, double * dx, double * dy)
+{
+    double dc2x = dcx*dcx - dcy*dcy, dc2y = 2.0*dcx*dcy;
+    double dc3x = dc2x*dcx - dc2y*dcy, dc3y = dc2x*dcy + dc2y*dcx;
+
+    //e = A*dc + B*dc^2 + C*dc^3
+    *ex = t->ax*dcx - t->ay*dcy + t->bx*dc2x - t->by*dc2y + t->cx*dc3x - t->cy*dc3y;
+    *ey = t->ax*dcy + t->ay*dcx + t->bx*dc2y + t->by*dc2x + t->cx*dc3y + t->cy*dc3x;
+
+    //de/dc = A + 2*B*dc + 3*C*dc^2
+    *dx = t->ax + 2.0*(t->bx*dcx - t->by*dcy) + 3.0*(t->cx*dc2x - t->cy*dc2y);
+    *dy = t->ay + 2.0*(t->bx*dcy + t->by*dcx) + 3.0*(t->cx*dc2y + t->cy*dc2x);
+}
+
+/**
+ * @brief Calculates the series coefficients of a reference orbit.
+ * @param r The reference orbit, with its positions already calculated.
+ */
+static void computeSeries(refOrbit * r)
+{
+    //A' = 2*Z*A + 1, B' = 2*Z*B + A^2 and C' = 2*Z*C + 2*A*B follow from inserting the series into e' = 2*Z*e + e*e + dc
+    r->series = (seriesTerm*) calloc(r->length + 1, sizeof(seriesTerm));
+    r->seriesLength = 0;
+    for(int n = 0; n < r->length; n++) {
+        const seriesTerm * t = &r->series[n];
+        seriesTerm * u = &r->series[n + 1];
+        double X2 = 2.0*r->x[n], Y2 = 2.0*r->y[n];
+
+        if(fabs(t->ax) + fabs(t->ay) > SERIES_LIMIT) break;
+
+        u->ax = X2*t->ax - Y2*t->ay + 1.0;
+        u->ay = X2*t->ay + Y2*t->ax;
+        u->bx = X2*t->bx - Y2*t->by + t->ax*t->ax - t->ay*t->ay;
+        u->by = X2*t->by + Y2*t->bx + 2.0*t->ax*t->ay;
+        u->cx = X2*t->cx - Y2*t->cy + 2.0*(t->ax*t->bx - t->ay*t->by);
+        u->cy = X2*t->cy + Y2*t->cx + 2.0*(t->ax*t->by + t->ay*t->bx);
+        r->seriesLength = n + 1;
+    }
+}
+
+refOrbit * perturb_createOrbit(doubleDouble cx, doubleDouble cy, int nMax)
+{
+    refOrbit * r = (refOrbit*) malloc(sizeof(refOrbit));
+    r->x = (double*) malloc(sizeof(double) * (nMax + 1));
+    r->y = (double*) malloc(sizeof(double) * (nMax + 1));
+
+    doubleDouble x = dd_fromDouble(0.0), y = dd_fromDouble(0.0);
+    int n = 0;
+    r->x[0] = 0.0;
+    r->y[0] = 0.0;
+
+    while(n < nMax) {
+        doubleDouble xy = dd_mul(x, y);
+        xy.hi *= 2.0;
+        xy.lo *= 2.0;
+
+        x = dd_add(dd_sub(dd_sqr(x), dd_sqr(y)), cx);
+        y = dd_add(xy, cy);
+        n++;
+
+        r->x[n] = dd_toDouble(x);
+        r->y[n] = dd_toDouble(y);
+
+        if(r->x[n]*r->x[n] + r->y[n]*r->y[n] >= 100.0) break;
+    }
+
+    r->length = n;
+
+    computeSeries(r);
+
+    return r;
+}
+
+refOrbit * perturb_createOrbitFixed(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax)
+{
+    refOrbit * r = (refOrbit*) malloc(sizeof(refOrbit));
+    r->x = (double*) malloc(sizeof(double) * (nMax + 1));
+    r->y = (double*) malloc(sizeof(double) * (nMax + 1));
+    r->length = fixed_orbit(bits, cx, cy, nMax, r->x, r->y);
+
+    computeSeries(r);
+
+    return r;
+}
+
+void perturb_destroyOrbit(refOrbit * r)
+{
+    free(r->x);
+    free(r->y);
+    free(r->series);
+    free(r);
+}
+
+int perturb_seriesSkip(const refOrbit * r, const double * dcx, const double * dcy, int count, int nMax, double tolerance)
+{
+    if(count == 0) return 0;
+
+    //the farthest point from the reference is where the series is the least accurate
+    int far = 0;
+    for(int a = 1; a < count; a++) {
+        if(dcx[a]*dcx[a] + dcy[a]*dcy[a] > dcx[far]*dcx[far] + dcy[far]*dcy[far]) far = a;
+    }
+    double radius = sqrt(dcx[far]*dcx[far] + dcy[far]*dcy[far]);
+
+    int limit = r->seriesLength;
+    if(limit > nMax - 1) limit = nMax - 1;
+    if(limit > r->length - 1) limit = r->length - 1;
+
+    int skip = 0;
+    for(int n = 1; n <= limit; n++) {
+        const seriesTerm * t = &r->series[n];
+        if(hypot(t->cx, t->cy) * radius > SERIES_TERM_RATIO * hypot(t->bx, t->by)) break;
+        skip = n;
+    }
+
+    if(skip == 0) return 0;
+
+    //the probes are iterated exactly, and the skip is lowered until the series agrees with all of them
+    int probes[3] = {0, count - 1, far};
+    int stride = skip + 1;
+    double * ex = (double*) malloc(sizeof(double) * 3 * stride);
+    double * ey = (double*) malloc(sizeof(double) * 3 * stride);
+
+    for(int p = 0; p < 3; p++) {
+        double x = 0.0, y = 0.0, xTemp = 0.0;
+        double cx = dcx[probes[p]], cy = dcy[probes[p]];
+
+        for(int n = 1; n <= skip; n++) {
+            double X2 = 2.0*r->x[n - 1], Y2 = 2.0*r->y[n - 1];
+            xTemp = (X2 + x)*x - (Y2 + y)*y + cx;
+            y = (X2 + x)*y + (Y2 + y)*x + cy;
+            x = xTemp;
+
+            //past a point where the orbit would have been rebased or escaped the exact offsets can not be compared
+            double zx = r->x[n] + x, zy = r->y[n] + y;
+            double mag = zx*zx + zy*zy;
+            if(mag >= 100.0 || mag < x*x + y*y) {
+                skip = n - 1;
+                break;
+            }
+
+            ex[p * stride + n] = x;
+            ey[p * stride + n] = y;
+        }
+    }
+
+    for(; skip > 0; skip--) {
+        const seriesTerm * t = &r->series[skip];
+        double allowed = tolerance * hypot(t->ax, t->ay);
+        bool valid = true;
+
+        for(int p = 0; p < 3 && valid; p++) {
+            double sx, sy, dx, dy;
+            seriesAt(t, dcx[probes[p]], dcy[probes[p]], &sx, &sy, &dx, &dy);
+            valid = hypot(sx - ex[p * stride + skip], sy - ey[p * stride + skip]) <= allowed;
+        }
+
+        if(valid) break;
+    }
+
+    free(ex);
+    free(ey);
+
+    return skip;
+}
+
+void perturb_inBrotList(const refOrbit * r, const double * dcx, const double * dcy, int count, int nMax, int skip, bool interiorCheck, perturbResult * out)
+{
+    for(int a = 0; a < count; a++) {
+        int i = skip, m = skip;
+        bool glitched = false, interior = false;
+        double ex = 0.0, ey = 0.0, exTemp = 0.0;
+        double dx = 0.0, dy = 0.0, dxTemp = 0.0;
+        double dzx = 1.0, dzy = 0.0, dzxTemp = 0.0;
+
+        //the first skip iterations are replaced by the series approximation
+        if(skip > 0) seriesAt(&r->series[skip], dcx[a], dcy[a], &ex, &ey, &dx, &dy);
+        double zx = r->x[m] + ex, zy = r->y[m] + ey;
+
+        while(i < nMax) {
+            //the reference escaped before this point did, there is nothing left to perturb
+            if(m >= r->length) {
+                glitched = true;
+                break;
+            }
+
+            double X2 = 2.0*r->x[m], Y2 = 2.0*r->y[m];
+
+            dxTemp = 2.0*(zx*dx - zy*dy) + 1.0;
+            dy = 2.0*(zx*dy + zy*dx);
+            dx = dxTemp;
+
+            //e' = 2*Z*e + e*e + dc
+            exTemp = (X2 + ex)*ex - (Y2 + ey)*ey + dcx[a];
+            ey = (X2 + ex)*ey + (Y2 + ey)*ex + dcy[a];
+            ex = exTemp;
+
+            i++;
+            m++;
+
+            zx = r->x[m] + ex;
+            zy = r->y[m] + ey;
+
+            double mag = zx*zx + zy*zy;
+            if(mag >= 100.0) break;
+
+            //when the orbit gets closer to 0 than the offset, the offset would lose the precision of the point (a glitch)
+            //the orbit is instead restarted as an offset from the start of the reference, where Z = 0 and the offset is z itself
+            if(mag < ex*ex + ey*ey) {
+                ex = zx;
+                ey = zy;
+                m = 0;
+            }
+
+            if(interiorCheck) {
+                dzxTemp = 2.0*(zx*dzx - zy*dzy);
+                dzy = 2.0*(zx*dzy + zy*dzx);
+                dzx = dzxTemp;
+
+                if(dzx*dzx + dzy*dzy < PERTURB_INTERIOR_EPSILON) {
+                    interior = true;
+                    break;
+                }
+            }
+        }
+
+        out[a].n = i;
+        out[a].skipped = skip;
+        out[a].x = zx;
+        out[a].y = zy;
+        out[a].dx = dx;
+        out[a].dy = dy;
+        out[a].interior = interior;
+        out[a].glitched = glitched;
+    }
+}
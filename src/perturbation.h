@@ -0,0 +1,99 @@
+/**
+ * @file perturbation.h
+ * @date 18/10 2026
+ * @brief Perturbation of a high precision reference orbit, used to iterate points of deep zooms as double precision offsets from the reference.
+ */
+
+#ifndef PERTURBATION_H
+#define PERTURBATION_H
+
+#include <stdbool.h>
+#include "doubledouble.h"
+#include "fixedpoint.h"
+
+/**
+ * @struct seriesTerm
+ * @brief the @ref seriesTerm struct holds the coefficients of the series e = A*dc + B*dc^2 + C*dc^3, which approximates the offset of a point close to the reference after some number of iterations.
+ */
+typedef struct seriesTerm {
+    double ax, ay; /**< the complex coefficient A */
+    double bx, by; /**< the complex coefficient B */
+    double cx, cy; /**< the complex coefficient C */
+} seriesTerm;
+
+/**
+ * @struct refOrbit
+ * @brief the @ref refOrbit struct is the orbit of one point, calculated in high precision and then rounded to doubles.
+ */
+typedef struct refOrbit {
+    int length; /**< the number of iterations before the reference escaped, or nMax */
+    double * x; /**< x-positions of the orbit, length + 1 values starting with 0 */
+    double * y; /**< y-positions of the orbit, length + 1 values starting with 0 */
+    int seriesLength; /**< the number of iterations with series coefficients, they are not calculated once they grow too large */
+    seriesTerm * series; /**< the series coefficients after every iteration, seriesLength + 1 values starting with 0 */
+} refOrbit;
+
+/**
+ * @struct perturbResult
+ * @brief the @ref perturbResult struct is the result of iterating one point with perturb_inBrotList.
+ */
+typedef struct perturbResult {
+    int n; /**< the final iteration-count */
+    int skipped; /**< the number of iterations skipped by the series approximation, included in n */
+    double x, y; /**< the position of the point after n iterations */
+    double dx, dy; /**< the derivative of the orbit with respect to the point */
+    bool interior; /**< if the derivative test found the point to be attracted by a cycle */
+    bool glitched; /**< if the reference escaped before the point, the point has to be iterated again with another reference */
+} perturbResult;
+
+/**
+ * @brief Calculates a reference orbit in double-double precision, together with its series coefficients.
+ * @param cx x-position of the reference in the complex-plane.
+ * @param cy y-position of the reference in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @return A refOrbit struct.
+ */
+refOrbit * perturb_createOrbit(doubleDouble cx, doubleDouble cy, int nMax);
+
+/**
+ * @brief Calculates a reference orbit in fixed-point, for zooms too deep for double-double, together with its series coefficients.
+ * @param bits The width of the fixed-point numbers, 128, 256, 512 or 1024.
+ * @param cx x-position of the reference in the complex-plane.
+ * @param cy y-position of the reference in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @return A refOrbit struct.
+ */
+refOrbit * perturb_createOrbitFixed(int bits, const fixedNumber * cx, const fixedNumber * cy, int nMax);
+
+/**
+ * @brief Destroy and deallocates a refOrbit struct.
+ * @param r A refOrbit struct.
+ */
+void perturb_destroyOrbit(refOrbit * r);
+
+/**
+ * @brief Finds how many iterations a list of points can skip with the series approximation. The number is first limited by requiring the last term of the series to be small compared to the one before for the offset farthest from the reference, and then validated by iterating the first, the last and the farthest point of the list exactly.
+ * @param r The reference orbit.
+ * @param dcx x-offsets from the reference.
+ * @param dcy y-offsets from the reference.
+ * @param count The number of points.
+ * @param nMax The maximum number of iterations.
+ * @param tolerance The largest error of the series, measured as a distance between points, that is accepted for the validated points.
+ * @return The number of iterations that can be skipped, 0 if none.
+ */
+int perturb_seriesSkip(const refOrbit * r, const double * dcx, const double * dcy, int count, int nMax, double tolerance);
+
+/**
+ * @brief Iterates a list of points given as offsets from the reference. When the orbit of a point gets closer to 0 than its offset it is rebased onto the start of the reference, so the offset never loses precision. A point is marked as glitched only when the reference escapes before it does.
+ * @param r The reference orbit.
+ * @param dcx x-offsets from the reference.
+ * @param dcy y-offsets from the reference.
+ * @param count The number of points.
+ * @param nMax The maximum number of iterations.
+ * @param skip The number of iterations to skip with the series approximation, as given by perturb_seriesSkip.
+ * @param interiorCheck If the derivative of the orbit should be used to detect interior points early.
+ * @param out count results, in the same order as the offsets.
+ */
+void perturb_inBrotList(const refOrbit * r, const double * dcx, const double * dcy, int count, int nMax, int skip, bool interiorCheck, perturbResult * out);
+
+#endif
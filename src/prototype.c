@@ -36,31 +36,34 @@ void printPPMImage(unsigned int * img, char * outputFile, int width, int height)
 
 /**
  * @brief Renders image of the mandelbrot set and writes it to a .ppm file
- * @param x X coordinate of image center
- * @param y Y coordinate of image center
+ * @param x X coordinate of image center, as a decimal string
+ * @param y Y coordinate of image center, as a decimal string
  * @param zoom Zoom percentage
  * @param c colorPalette chosen
  * @param fileName Target filename
  */
-void renderImage(double x, double y, double zoom, colorPalette * c, char * fileName)
+void renderImage(const char * x, const char * y, double zoom, colorPalette * c, char * fileName)
 {
     int iterations = 1024*2, imageWidth = 512*4, imageHeight = 512*4;
     double ratio = (double)imageHeight/(double)imageWidth;
 
-    struct mandelData * d = mandel_createMandelData(iterations, x-1/zoom, y+1/zoom*ratio, x+1/zoom, y-1/zoom*ratio, imageWidth, imageHeight, c);
+    //the view is created around 0 and then moved, since the center may have more digits than a double can hold
+    struct mandelData * d = mandel_createMandelData(iterations, -1/zoom, 1/zoom*ratio, 1/zoom, -1/zoom*ratio, imageWidth, imageHeight, c);
+    mandel_setCenterString(d, x, y);
+    mandel_setAutoIterations(d, true);
 
-    printPPMImage(mandel_render(d, 1, 1), fileName, imageWidth, imageHeight);
-    mandel_render(d, 8, 8);
+    printPPMImage(mandel_render(d, MANDEL_AUTO, MANDEL_AUTO), fileName, imageWidth, imageHeight);
+    mandel_render(d, MANDEL_AUTO, MANDEL_AUTO);
     mandel_destroyMandelData(d);
 }
 
 int main()
 {
     // interesting coordinates
-    //double x = 0.001643721971153, y = 0.8224676332988;
-    //double x = -0.77568377, y = 0.13646737;
-    //double x = -1.768573656315270993281742915329544712934120053, y = -0.00096429685135828000017642720373819448274776122656563565285783153307047554366;
-    double x = 0.0, y = 0.0;
+    //const char * x = "0.001643721971153", * y = "0.8224676332988";
+    //const char * x = "-0.77568377", * y = "0.13646737";
+    //const char * x = "-1.768573656315270993281742915329544712934120053", * y = "-0.00096429685135828000017642720373819448274776122656563565285783153307047554366";
+    const char * x = "0.0", * y = "0.0";
     double zoom = 1;
 
     colorPalette * c = color_createPalette(7);
@@ -15,11 +15,17 @@ extern "C" {
 
 using namespace sf;
 
+// the julia mode renders each frame within this many seconds, leaving the rest of a 16 ms frame for drawing it
+#define JULIA_FRAME_BUDGET 0.012
+#define JULIA_ITERATIONS 256
+
 int main()
 {
   unsigned int width = 700, height = 700;
   int dimensions = width*height, i = 0, iterations = 1000;
-  double x = 0, y = 0, zoom = 0.5; 
+  double zoom = 0.5;
+  // the center is kept in double-double so that deep zooms do not drift
+  doubleDouble x = dd_fromDouble(0), y = dd_fromDouble(0);
   float a = 550, b = 200;
 
   colorPalette * c = color_createPalette(7);
@@ -33,15 +39,28 @@ int main()
 
   //class RenderWindow with right list
   sf::RenderWindow window(sf::VideoMode(width,height), "RenderWindow window");
+
+  // the texture is created once and updated from the image, so drawing a frame allocates nothing
+  sf::Texture texture;
+  texture.create(width, height);
+  sf::Sprite sprite;
+  sprite.setTexture(texture);
+
+  // in the julia mode the mouse sets the seed of a julia-set, which is rendered by a realtime renderer at display rate
+  bool juliaMode = false;
+  struct mandelData * julia = NULL;
+  mandelRealtime * realtime = NULL;
   
   //class Vertex 
   sf::Vertex vertex(sf::Vector2f(10, 50), sf::Color::Red, sf::Vector2f(100, 100)); 
   
   //mandeldata struct
-  struct mandelData * d = mandel_createMandelData(iterations, x-1/zoom, y+1/zoom, x+1/zoom, y-1/zoom, width, height, c);
+  struct mandelData * d = mandel_createMandelData(iterations, -1/zoom, 1/zoom, 1/zoom, -1/zoom, width, height, c);
+  mandel_setCenter(d, x, y);
+  mandel_setAutoIterations(d, true);
 
   // render first image
-  renderThread * currentRender = mandel_renderUnfinished(d, 4, 2);
+  renderThread * currentRender = mandel_renderUnfinished(d, MANDEL_AUTO, MANDEL_AUTO);
   unsigned int *pixels = currentRender->image;
 
   while (window.isOpen())
@@ -52,7 +71,7 @@ int main()
 	  // close window
 	  if (event.type == sf::Event::Closed)
 	    window.close();
-	  if (event.type == sf::Event::MouseButtonPressed) {
+	  if (event.type == sf::Event::MouseButtonPressed && !juliaMode) {
 	    if(event.mouseButton.button == sf::Mouse::Left) {
 	      int mx = event.mouseButton.x;
 	      int my = event.mouseButton.y;
@@ -60,18 +79,18 @@ int main()
 	      double dx = (double)mx / (double)width;
 	      double dy = (double)my / (double)height;
 	      
-	      x = x - 1.0/zoom + dx * (2.0/zoom);
-	      y = y + 1.0/zoom - dy * (2.0/zoom);
+	      x = dd_add(x, dd_fromDouble(-1.0/zoom + dx * (2.0/zoom)));
+	      y = dd_add(y, dd_fromDouble(1.0/zoom - dy * (2.0/zoom)));
 	      zoom *= 2.0;
 
-	      // free resources form old image
+	      // wait for the old image, the visualization and its threads are kept
 	      pthread_join(currentRender->thread, NULL);
 	      free(currentRender);
-	      mandel_destroyMandelData(d);
 
 	      // render new image
-	      d = mandel_createMandelData(iterations, x-1/zoom, y+1/zoom, x+1/zoom, y-1/zoom, width, height, c);
-	      currentRender = mandel_renderUnfinished(d, 4, 16);
+	      mandel_setLocation(d, -1/zoom, 1/zoom, 1/zoom, -1/zoom);
+	      mandel_setCenter(d, x, y);
+	      currentRender = mandel_renderUnfinished(d, MANDEL_AUTO, MANDEL_AUTO);
 	      pixels = currentRender->image;
 	    }
 	    if(event.mouseButton.button == sf::Mouse::Right) {
@@ -81,43 +100,74 @@ int main()
 	      double dx = (double)mx / (double)width;
 	      double dy = (double)my / (double)height;
 	      
-	      x = x - 1.0/zoom + dx * (2.0/zoom);
-	      y = y + 1.0/zoom - dy * (2.0/zoom);
+	      x = dd_add(x, dd_fromDouble(-1.0/zoom + dx * (2.0/zoom)));
+	      y = dd_add(y, dd_fromDouble(1.0/zoom - dy * (2.0/zoom)));
 	      zoom *= 0.5;
 
-	      // free resources form old image
+	      // wait for the old image, the visualization and its threads are kept
 	      pthread_join(currentRender->thread, NULL);
 	      free(currentRender);
-	      mandel_destroyMandelData(d);
 
 	      // render new image
-	      d = mandel_createMandelData(iterations, x-1/zoom, y+1/zoom, x+1/zoom, y-1/zoom, width, height, c);
-	      currentRender = mandel_renderUnfinished(d, 4, 16);
+	      mandel_setLocation(d, -1/zoom, 1/zoom, 1/zoom, -1/zoom);
+	      mandel_setCenter(d, x, y);
+	      currentRender = mandel_renderUnfinished(d, MANDEL_AUTO, MANDEL_AUTO);
 	      pixels = currentRender->image;
 	    }
 
 	  }
+	  // more iterations, only the pixels that reached the old cap are iterated further
+	  if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::I && !juliaMode) {
+	    pthread_join(currentRender->thread, NULL);
+	    free(currentRender);
+
+	    iterations = mandel_getIterations(d) * 2;
+	    mandel_setIterations(d, iterations);
+	    currentRender = mandel_renderUnfinished(d, MANDEL_AUTO, MANDEL_AUTO);
+	    pixels = currentRender->image;
+	  }
+	  // toggle the julia mode, the mandelbrot view is kept underneath
+	  if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::J) {
+	    juliaMode = !juliaMode;
+	    if(juliaMode) {
+	      julia = mandel_createMandelData(JULIA_ITERATIONS, -1.6, 1.6, 1.6, -1.6, width, height, c);
+	      mandel_setFormula(julia, MANDEL_FORMULA_JULIA, 2);
+	      realtime = mandel_createRealtime(julia, MANDEL_AUTO);
+	      window.setFramerateLimit(60);
+	    } else {
+	      mandel_destroyRealtime(realtime);
+	      mandel_destroyMandelData(julia);
+	      realtime = NULL;
+	      julia = NULL;
+	      pixels = currentRender->image;
+	      window.setFramerateLimit(0);
+	    }
+	  }
+	  // the seed is the point of the mandelbrot view under the mouse
+	  if (event.type == sf::Event::MouseMoved && juliaMode) {
+	    double dx = (double)event.mouseMove.x / (double)width;
+	    double dy = (double)event.mouseMove.y / (double)height;
+	    mandel_setJuliaSeed(julia, dd_toDouble(x) - 1.0/zoom + dx * (2.0/zoom), dd_toDouble(y) + 1.0/zoom - dy * (2.0/zoom));
+	  }
         }
 
+      if(juliaMode) pixels = mandel_renderFrame(realtime, JULIA_FRAME_BUDGET);
+
       // set black background color
       window.clear(sf::Color(80,80,80));
-      sf::Image image;
-      
-      image.create(width, height, (const Uint8*)pixels);
-
-      sf::Texture texture;
-      sf::Rect<int> r(0, 0, width, height);
-      texture.loadFromImage(image, r);
-	
-      sf::Sprite sprite;
-      sprite.setTexture(texture);
-      
+      texture.update((const Uint8*)pixels);
       window.draw(sprite);
       window.display();
 
-      sf::sleep(sf::milliseconds(100));
+      // the julia mode is paced by the frame limit instead
+      if(!juliaMode) sf::sleep(sf::milliseconds(100));
     }
 
+  if(juliaMode) {
+    mandel_destroyRealtime(realtime);
+    mandel_destroyMandelData(julia);
+  }
+
   pthread_join(currentRender->thread, NULL);
   free(currentRender);
   color_destroyPalette(c);
@@ -5,6 +5,11 @@
  * @brief Thread pool with constant amount of threads
  */
 
+//cpu affinity is a GNU extension
+#define _GNU_SOURCE
+
+#include <sched.h>
+#include <stdio.h>
 #include "../include/threadpool.h"
 
 ////////////
@@ -30,9 +35,14 @@ typedef struct job {
  */
 typedef struct jobQueue {
     /*@{*/
-    fifo * jobs; /**< fifo queue containing the jobs */
+    fifo * jobs; /**< fifo queue containing the jobs for any thread */
+    fifo ** local; /**< one fifo queue per thread, containing the jobs it should run */
+    int numLocal; /**< the number of local queues */
+    int queued; /**< the number of jobs in all queues */
     pthread_mutex_t lock; /**< mutex lock */
     pthread_cond_t notEmpty; /**< condition variable */
+    pthread_cond_t idle; /**< signaled when the last pending job is done */
+    int pending; /**< the number of jobs queued or running */
     /*@}*/
 } jobQueue;
 
@@ -44,32 +54,62 @@ typedef struct jobQueue {
 typedef struct threadpool {
     /*@{*/
     pthread_t * threads;  /**< the threads of the threadpool */
+    struct worker * workers;  /**< the arguments of the threads */
     int numThreads;  /**< the number of threads */
     jobQueue * queue;  /**< the jobQueue */
     bool isRunning;  /**< if threadpool is active or not */
     /*@}*/
 } threadpool;
 
+/**
+ * @struct worker
+ * @brief the argument of a thread of a @ref threadpool
+ *
+ */
+typedef struct worker {
+    /*@{*/
+    threadpool * pool; /**< the threadpool */
+    int index; /**< the index of the thread and its local queue */
+    /*@}*/
+} worker;
+
 /////////////
 //Functions//
 /////////////
 
+/** the worker run by the calling thread, set by each thread of a pool when it starts */
+static pthread_key_t currentWorker;
+static pthread_once_t currentWorkerOnce = PTHREAD_ONCE_INIT;
+
+void currentWorkerCreate(void)
+{
+    pthread_key_create(&currentWorker, NULL);
+}
+
 void jobDestructor(void* vjob)
 {
     free((job*)vjob);
 }
 
-jobQueue * jobQueueCreate()
+jobQueue * jobQueueCreate(int numLocal)
 {
     // alloc mem
     jobQueue * queue = malloc(sizeof(jobQueue));
 
     // create the jobs structure
     queue->jobs = fifo_create(jobDestructor);
+    queue->local = malloc(sizeof(fifo*) * numLocal);
+    for(int i = 0; i < numLocal; ++i) {
+        queue->local[i] = fifo_create(jobDestructor);
+    }
+    queue->numLocal = numLocal;
+    queue->queued = 0;
 
     // locks
     pthread_mutex_init(&queue->lock, NULL);
     pthread_cond_init(&queue->notEmpty, NULL);
+    pthread_cond_init(&queue->idle, NULL);
+    queue->pending = 0;
 
     return queue;
 }
@@ -78,11 +118,21 @@ void jobQueueDestroy(jobQueue * queue)
 {
     pthread_mutex_destroy(&(queue->lock));
     pthread_cond_destroy(&(queue->notEmpty));
+    pthread_cond_destroy(&(queue->idle));
     fifo_destroy(queue->jobs);
+    for(int i = 0; i < queue->numLocal; ++i) {
+        fifo_destroy(queue->local[i]);
+    }
+    free(queue->local);
     free(queue);
 }
 
 void threadpool_enqueue(threadpool * pool, void(*routine)(void*), void * arg)
+{
+    threadpool_enqueueTo(pool, routine, arg, -1);
+}
+
+void threadpool_enqueueTo(threadpool * pool, void(*routine)(void*), void * arg, int thread)
 {
     job * newJob = malloc(sizeof(job));
     newJob->routine = routine;
@@ -92,35 +142,68 @@ void threadpool_enqueue(threadpool * pool, void(*routine)(void*), void * arg)
         pthread_mutex_unlock(&pool->queue->lock);
         return;
     }
-    if(fifo_isempty(pool->queue->jobs)) {
-        pthread_cond_signal(&pool->queue->notEmpty);
-    }
-    fifo_enqueue(pool->queue->jobs, (void*)newJob);
+    //every job wakes a thread, a thread woken for an earlier job may still be running it when this one arrives
+    //any thread may steal the job, so waking whichever thread is waiting is enough
+    if(thread >= 0 && thread < pool->queue->numLocal) fifo_enqueue(pool->queue->local[thread], (void*)newJob);
+    else fifo_enqueue(pool->queue->jobs, (void*)newJob);
+    pool->queue->queued++;
+    pool->queue->pending++;
+    pthread_cond_signal(&pool->queue->notEmpty);
     pthread_mutex_unlock(&pool->queue->lock);
 }
 
-void * doWork(void * voidpool)
+/**
+ * @brief Takes the next job for a thread, from its own queue first, then from the queue for any thread, and last from the queues of the other threads.
+ * @param queue The queues, locked by the caller and not empty.
+ * @param index The index of the thread.
+ * @return The job.
+ */
+job * takeJob(jobQueue * queue, int index)
 {
-    threadpool * pool = (threadpool*) voidpool;
+    queue->queued--;
+
+    if(!fifo_isempty(queue->local[index])) return (job*)fifo_dequeue(queue->local[index]);
+    if(!fifo_isempty(queue->jobs)) return (job*)fifo_dequeue(queue->jobs);
+
+    for(int i = 1; i < queue->numLocal; ++i) {
+        fifo * other = queue->local[(index + i) % queue->numLocal];
+        if(!fifo_isempty(other)) return (job*)fifo_dequeue(other);
+    }
+
+    return NULL;
+}
+
+void * doWork(void * voidworker)
+{
+    worker * w = (worker*) voidworker;
+    threadpool * pool = w->pool;
+
+    //set by the thread itself, pool->threads[] may not be written yet when its first job runs
+    pthread_setspecific(currentWorker, w);
 
     while(1) {
         pthread_mutex_lock(&pool->queue->lock);
 
-        while( pool->isRunning && fifo_isempty(pool->queue->jobs) ) {
+        while( pool->isRunning && pool->queue->queued == 0 ) {
             pthread_cond_wait(&pool->queue->notEmpty, &pool->queue->lock);
         }
 
-        if(!pool->isRunning && fifo_isempty(pool->queue->jobs)) {
+        if(!pool->isRunning && pool->queue->queued == 0) {
             break;
         }
 
-        job * j = (job*)fifo_dequeue(pool->queue->jobs);
+        job * j = takeJob(pool->queue, w->index);
 
         pthread_mutex_unlock(&pool->queue->lock);
 
         if (j != NULL) {
             j->routine(j->arg);
             free(j);
+
+            //the job counts as pending until it is done, since it may have added more jobs while it ran
+            pthread_mutex_lock(&pool->queue->lock);
+            if(--pool->queue->pending == 0) pthread_cond_broadcast(&pool->queue->idle);
+            pthread_mutex_unlock(&pool->queue->lock);
         }
     }
     pthread_mutex_unlock(&pool->queue->lock);
@@ -133,22 +216,111 @@ threadpool * threadpool_create(int numThreads)
     // alloc memory
     threadpool * pool = malloc(sizeof(struct threadpool));
     pool->threads = calloc(numThreads, sizeof(pthread_t));
+    pool->workers = calloc(numThreads, sizeof(worker));
     pool->numThreads = numThreads;
 
     pool->isRunning = true;
+    pthread_once(&currentWorkerOnce, currentWorkerCreate);
 
     // create contents
-    pool->queue = jobQueueCreate();
+    pool->queue = jobQueueCreate(numThreads);
     for(int i=0; i<numThreads; ++i) {
-        pthread_create(&pool->threads[i], NULL, doWork, pool);
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        pthread_create(&pool->threads[i], NULL, doWork, &pool->workers[i]);
     }
 
 
     return pool;
 }
 
+int threadpool_currentThread(threadpool * pool)
+{
+    pthread_once(&currentWorkerOnce, currentWorkerCreate);
+    worker * w = (worker*)pthread_getspecific(currentWorker);
+    if(w == NULL || w->pool != pool) return -1;
+    return w->index;
+}
+
+#ifdef CPU_SET
+/**
+ * @brief Reads a list of cpus or nodes in the format of sysfs, such as 0-3,8-11.
+ * @param path The file of the list.
+ * @param set The set to fill with the cpus or nodes of the list.
+ * @return true if the file could be read.
+ */
+bool readCpuList(const char * path, cpu_set_t * set)
+{
+    FILE * file = fopen(path, "r");
+    if(file == NULL) return false;
+
+    CPU_ZERO(set);
+    int from, to;
+    char separator = ',';
+    while(separator == ',' && fscanf(file, "%d", &from) == 1) {
+        to = from;
+        separator = '\n';
+        if(fscanf(file, "%c", &separator) == 1 && separator == '-') {
+            separator = '\n';
+            if(fscanf(file, "%d%c", &to, &separator) < 1) to = from;
+        }
+        for(int cpu = from; cpu <= to && cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, set);
+    }
+
+    fclose(file);
+    return true;
+}
+#endif
+
+void threadpool_pinThreads(threadpool * pool)
+{
+#ifdef CPU_SET
+    cpu_set_t allowed, nodes;
+    if(sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) return;
+    if(!readCpuList("/sys/devices/system/node/online", &nodes) || CPU_COUNT(&nodes) <= 1) return;
+
+    //the threads are spread evenly over the allowed cpus, so that they cover every node when there are fewer threads than cpus
+    int numCpus = CPU_COUNT(&allowed);
+    for(int i = 0; i < pool->numThreads; ++i) {
+        int k = (int)((long long)i * numCpus / pool->numThreads % numCpus);
+        int cpu = -1;
+        while(k >= 0) {
+            if(CPU_ISSET(++cpu, &allowed)) k--;
+        }
+
+        //each thread may run on any allowed cpu of the node of its cpu, so threads beyond the number of cpus are balanced within the node
+        for(int node = 0; node < CPU_SETSIZE; ++node) {
+            if(!CPU_ISSET(node, &nodes)) continue;
+
+            char path[64];
+            cpu_set_t set;
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            if(!readCpuList(path, &set) || !CPU_ISSET(cpu, &set)) continue;
+
+            CPU_AND(&set, &set, &allowed);
+            pthread_setaffinity_np(pool->threads[i], sizeof(cpu_set_t), &set);
+            break;
+        }
+    }
+#else
+    (void)pool;
+#endif
+}
+
+void threadpool_wait(threadpool * pool)
+{
+    pthread_mutex_lock(&pool->queue->lock);
+    while(pool->queue->pending > 0) {
+        pthread_cond_wait(&pool->queue->idle, &pool->queue->lock);
+    }
+    pthread_mutex_unlock(&pool->queue->lock);
+}
+
 void threadpool_destroy(threadpool * pool)
 {
+    //a running job may still add jobs, which would be dropped once the pool stops
+    threadpool_wait(pool);
+
     pthread_mutex_lock(&pool->queue->lock);
     pool->isRunning = false;
     pthread_cond_broadcast(&pool->queue->notEmpty);
@@ -161,5 +333,6 @@ void threadpool_destroy(threadpool * pool)
     }
     jobQueueDestroy(pool->queue);
     free(pool->threads);
+    free(pool->workers);
     free(pool);
 }
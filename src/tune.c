@@ -0,0 +1,32 @@
+/**
+ * @file tune.c
+ * @date 18/10 2026
+ * @brief Calibrates the settings of the renders with MANDEL_AUTO for this host and stores them in the profile file.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "../include/mandelbrot.h"
+
+/**
+ * @brief Tunes the image sizes given as width and height pairs on the command line, or the sizes of the GUI and the prototype if none are given.
+ */
+int main(int argc, char * argv[])
+{
+    //the GUI renders 700*700 and the prototype 2048*2048
+    int defaults[] = {700, 700, 2048, 2048};
+    int count = argc > 2 ? (argc - 1) / 2 : 2;
+
+    for(int a = 0; a < count; a++) {
+        int width = argc > 2 ? atoi(argv[1 + 2 * a]) : defaults[2 * a];
+        int height = argc > 2 ? atoi(argv[2 + 2 * a]) : defaults[2 * a + 1];
+
+        printf("Tuning %dx%d...\n", width, height);
+        if(width <= 0 || height <= 0 || !mandel_tune(NULL, width, height)) {
+            fprintf(stderr, "Could not tune %dx%d into %s\n", width, height, MANDEL_PROFILE_FILE);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file test_buddhabrot.c
+ * @date 18/10 2026
+ * @brief Tests for the buddhabrot chains
+ */
+
+#include "minunit.h"
+#include "../src/buddhabrot.h"
+
+static buddhaView view = {-2.0, 1.5, 3.0, -3.0, 64, 64};
+
+void test_setup()
+{
+
+}
+
+void test_teardown()
+{
+    // Nothing
+}
+
+MU_TEST(test_buddha_orbit)
+{
+    buddhaChain * c = buddha_createChain(&view, 100, 1);
+    double x[100], y[100];
+
+    mu_assert(buddha_orbit(c, 0.0, 0.0, 100, x, y) == 0, "0 is in the set");
+    mu_assert(c->iterations == 0 && c->cardioidSaved == 100, "0 should be rejected by the cardioid test");
+
+    mu_assert(buddha_orbit(c, -1.31, 0.0, 100, x, y) == 0, "-1.31 is in the set");
+    mu_assert(c->periodSaved > 0, "the orbit of -1.31 should be found periodic");
+
+    int length = buddha_orbit(c, 1.0, 1.0, 100, x, y);
+    mu_assert(length == 2, "1 + i escapes after 2 iterations");
+    mu_assert(x[0] == 1.0 && y[0] == 1.0 && x[1] == 1.0 && y[1] == 3.0, "the orbit of 1 + i is 1 + i, 1 + 3i");
+
+    buddha_destroyChain(c);
+}
+
+MU_TEST(test_buddha_contribution)
+{
+    double x[3] = {0.5, 0.5, 5.0};
+    double y[3] = {0.5, 0.0, 0.0};
+
+    //both 0.5 + 0.5i and its mirror image are inside, 0.5 is counted twice and 5 is outside
+    mu_assert(buddha_contribution(&view, x, y, 3) == 4, "the contribution should be 4");
+    mu_assert(buddha_contribution(&view, x, y, 0) == 0, "an empty orbit contributes nothing");
+}
+
+//every step adds a total weight of at most 1 to the histogram, and the mirror images make it symmetric
+MU_TEST(test_buddha_run)
+{
+    buddhaChain * c = buddha_createChain(&view, 200, 7);
+
+    mu_assert(buddha_seed(c, &view, 200, 100), "a seed should be found in the whole set");
+    buddha_run(c, &view, 200, 2000);
+
+    double sum = 0.0, asymmetry = 0.0;
+    for(int row = 0; row < view.height; row++) {
+        for(int col = 0; col < view.width; col++) {
+            sum += c->histogram[row * view.width + col];
+            asymmetry += fabs(c->histogram[row * view.width + col] - c->histogram[(view.height - 1 - row) * view.width + col]);
+        }
+    }
+
+    mu_assert(sum > 0.0 && sum <= 2000.0 + 1e-3, "the histogram should sum to at most the number of steps");
+    mu_assert(asymmetry < 1e-2, "the histogram should be symmetric across the real axis");
+
+    buddha_destroyChain(c);
+}
+
+MU_TEST_SUITE(test_suite)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_buddha_orbit);
+    MU_RUN_TEST(test_buddha_contribution);
+    MU_RUN_TEST(test_buddha_run);
+}
+
+int main(int argc, char *argv[])
+{
+    MU_RUN_SUITE(test_suite);
+    MU_REPORT();
+    return 0;
+}
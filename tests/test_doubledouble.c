@@ -0,0 +1,92 @@
+/**
+ * @file test_doubledouble.c
+ * @date 18/10 2026
+ * @brief Tests for the double-double arithmetic
+ */
+
+#include "minunit.h"
+#include "../src/doubledouble.h"
+
+void test_setup()
+{
+
+}
+
+void test_teardown()
+{
+    // Nothing
+}
+
+//1 + 2^-80 is not representable as a double, but the low part must survive
+MU_TEST(test_dd_addKeepsLowPart)
+{
+    doubleDouble a = dd_add(dd_fromDouble(1.0), dd_fromDouble(ldexp(1.0, -80)));
+    mu_assert(a.hi == 1.0, "hi should be 1");
+    mu_assert(a.lo == ldexp(1.0, -80), "lo should be 2^-80");
+
+    doubleDouble b = dd_sub(a, dd_fromDouble(1.0));
+    mu_assert(dd_toDouble(b) == ldexp(1.0, -80), "(1 + 2^-80) - 1 should be 2^-80");
+}
+
+//(1 + 2^-40)^2 = 1 + 2^-39 + 2^-80, which needs more than 53 bits
+MU_TEST(test_dd_sqr)
+{
+    doubleDouble a = dd_add(dd_fromDouble(1.0), dd_fromDouble(ldexp(1.0, -40)));
+    doubleDouble sq = dd_sqr(a);
+    doubleDouble m = dd_mul(a, a);
+    doubleDouble r = dd_sub(sq, dd_fromDouble(1.0 + ldexp(1.0, -39)));
+
+    mu_assert(dd_toDouble(r) == ldexp(1.0, -80), "the square should keep the 2^-80 term");
+    mu_assert(sq.hi == m.hi && sq.lo == m.lo, "sqr and mul should agree");
+}
+
+MU_TEST(test_dd_div)
+{
+    doubleDouble third = dd_div(dd_fromDouble(1.0), dd_fromDouble(3.0));
+    doubleDouble one = dd_mul(third, dd_fromDouble(3.0));
+
+    mu_assert(fabs(dd_toDouble(dd_sub(one, dd_fromDouble(1.0)))) < 1e-31, "3 * (1 / 3) should be 1 to 31 digits");
+}
+
+MU_TEST(test_dd_fromString)
+{
+    doubleDouble a = dd_fromString("-1.768573656315270993281742915329544712934120053");
+    doubleDouble b = dd_fromString("-1.768573656315270993281742915339544712934120053");
+    double diff = dd_toDouble(dd_sub(b, a));
+
+    mu_assert(a.hi == -1.768573656315270993281742915329544712934120053, "hi should be the nearest double");
+    mu_assert(fabs(diff + 1e-29) < 1e-31, "a difference in the 29th decimal should be kept");
+    mu_assert(dd_toDouble(dd_fromString("2.5e-3")) == 0.0025, "exponent should be parsed");
+    mu_assert(dd_toDouble(dd_fromString("garbage")) == 0.0, "a non-number should be 0");
+}
+
+MU_TEST(test_dd_inBrotList)
+{
+    doubleDouble x0[3] = {{0.0, 0.0}, {1.0, 0.0}, {-1.0, 0.0}};
+    doubleDouble y0[3] = {{0.0, 0.0}, {1.0, 0.0}, {0.0, 0.0}};
+    ddResult out[3];
+
+    dd_inBrotList(x0, y0, 3, 100, 1e-13, out);
+
+    mu_assert(out[0].n == 100 || out[0].periodic, "0 is in the set");
+    mu_assert(out[1].n < 10 && !out[1].periodic, "1 + i escapes fast");
+    mu_assert(out[2].periodic, "-1 has a cycle of period 2");
+}
+
+MU_TEST_SUITE(test_suite)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_dd_addKeepsLowPart);
+    MU_RUN_TEST(test_dd_sqr);
+    MU_RUN_TEST(test_dd_div);
+    MU_RUN_TEST(test_dd_fromString);
+    MU_RUN_TEST(test_dd_inBrotList);
+}
+
+int main(int argc, char *argv[])
+{
+    MU_RUN_SUITE(test_suite);
+    MU_REPORT();
+    return 0;
+}
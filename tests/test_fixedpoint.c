@@ -0,0 +1,110 @@
+/**
+ * @file test_fixedpoint.c
+ * @date 18/10 2026
+ * @brief Tests for the multi-limb fixed-point arithmetic
+ */
+
+#include "minunit.h"
+#include <string.h>
+#include "../src/fixedpoint.h"
+
+void test_setup()
+{
+
+}
+
+void test_teardown()
+{
+    // Nothing
+}
+
+MU_TEST(test_fixed_fromDouble)
+{
+    mu_assert(fixed_toDouble(fixed_fromDouble(-1.75)) == -1.75, "-1.75 should survive the conversion");
+    mu_assert(fixed_toDouble(fixed_fromDouble(0.1)) == 0.1, "0.1 should survive the conversion");
+
+    doubleDouble d = dd_add(dd_fromDouble(1.0), dd_fromDouble(ldexp(1.0, -80)));
+    fixedNumber f = fixed_sub(fixed_fromDoubleDouble(d), fixed_fromDouble(1.0));
+    mu_assert(fixed_toDouble(f) == ldexp(1.0, -80), "the low part of a doubleDouble should be kept");
+}
+
+MU_TEST(test_fixed_addSub)
+{
+    fixedNumber a = fixed_fromDouble(0.25), b = fixed_fromDouble(-1.5);
+
+    mu_assert(fixed_toDouble(fixed_add(a, b)) == -1.25, "0.25 + -1.5 should be -1.25");
+    mu_assert(fixed_toDouble(fixed_sub(a, b)) == 1.75, "0.25 - -1.5 should be 1.75");
+    mu_assert(fixed_toDouble(fixed_sub(b, b)) == 0.0, "b - b should be 0");
+}
+
+MU_TEST(test_fixed_mulSqr)
+{
+    fixedNumber a = fixed_fromString("1.000000000000000000000000000000000000000000000000000000000001");
+    fixedNumber b = fixed_fromDouble(-3.0);
+    fixedNumber sq = fixed_sqr(a), m = fixed_mul(a, a);
+
+    mu_assert(fixed_toDouble(fixed_mul(b, b)) == 9.0, "-3 * -3 should be 9");
+    mu_assert(fixed_toDouble(fixed_mul(a, b)) == -3.0, "a * -3 should be about -3");
+    mu_assert(memcmp(sq.limb, m.limb, sizeof(sq.limb)) == 0, "sqr and mul should agree");
+
+    //(1 + 1e-60)^2 - 1 = 2e-60 + 1e-120
+    double diff = fixed_toDouble(fixed_sub(sq, fixed_fromDouble(1.0)));
+    mu_assert(fabs(diff - 2e-60) < 1e-72, "the square should keep the 2e-60 term");
+}
+
+MU_TEST(test_fixed_fromString)
+{
+    fixedNumber a = fixed_fromString("-1.768573656315270993281742915329544712934120053");
+    fixedNumber b = fixed_fromString("-1.768573656315270993281742915329544712934120054");
+    double diff = fixed_toDouble(fixed_sub(a, b));
+
+    mu_assert(fixed_toDouble(a) == -1.768573656315270993281742915329544712934120053, "the number should round to the nearest double");
+    mu_assert(fabs(diff - 1e-45) < 1e-57, "a difference in the 45th decimal should be kept");
+    mu_assert(fixed_toDouble(fixed_fromString("2.5e-3")) == 0.0025, "exponent should be parsed");
+    mu_assert(fixed_toDouble(fixed_fromString("garbage")) == 0.0, "a non-number should be 0");
+}
+
+MU_TEST(test_fixed_bitsFor)
+{
+    mu_assert(fixed_bitsFor(1e-20, 512.0) == 128, "128 bits should resolve 1e-20");
+    mu_assert(fixed_bitsFor(1e-40, 512.0) == 256, "256 bits are needed for 1e-40");
+    mu_assert(fixed_bitsFor(1e-300, 512.0) == 1024, "1024 bits is the widest format");
+}
+
+//every width should agree with double precision on points that are not close to the boundary
+MU_TEST(test_fixed_inBrot)
+{
+    fixedNumber x1 = fixed_fromDouble(0.3), y1 = fixed_fromDouble(0.5);
+    fixedNumber x2 = fixed_fromDouble(-1.0), y2 = fixed_fromDouble(0.0);
+    double ox[101], oy[101];
+
+    for(int bits = 128; bits <= 1024; bits *= 2) {
+        fixedResult r = fixed_inBrot(bits, &x1, &y1, 1000);
+        mu_assert(r.n == 1000 || r.x*r.x + r.y*r.y >= 100.0, "the result should have escaped or reached nMax");
+        mu_assert(fixed_inBrot(bits, &x2, &y2, 100).n == 100, "-1 is in the set");
+        mu_assert(fixed_orbit(bits, &x2, &y2, 100, ox, oy) == 100, "-1 never escapes");
+        mu_assert(ox[1] == -1.0 && ox[2] == 0.0 && ox[3] == -1.0, "-1 should alternate between -1 and 0");
+    }
+
+    fixedNumber x3 = fixed_fromDouble(1.0), y3 = fixed_fromDouble(1.0);
+    mu_assert(fixed_inBrot(256, &x3, &y3, 100).n == 4, "1 + i escapes after 4 iterations");
+}
+
+MU_TEST_SUITE(test_suite)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_fixed_fromDouble);
+    MU_RUN_TEST(test_fixed_addSub);
+    MU_RUN_TEST(test_fixed_mulSqr);
+    MU_RUN_TEST(test_fixed_fromString);
+    MU_RUN_TEST(test_fixed_bitsFor);
+    MU_RUN_TEST(test_fixed_inBrot);
+}
+
+int main(int argc, char *argv[])
+{
+    MU_RUN_SUITE(test_suite);
+    MU_REPORT();
+    return 0;
+}
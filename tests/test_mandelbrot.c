@@ -0,0 +1,303 @@
+/**
+ * @file test_mandelbrot.c
+ * @date 18/10 2026
+ * @brief Tests for the tiles, mirrored rows, resumed renders, realtime frames, pinned threads, renders with a time budget and the tiled layout of the mandelbrot renderer
+ */
+
+#include "minunit.h"
+#include "../src/mandelbrot.c"
+
+static colorPalette * palette;
+
+void test_setup()
+{
+    palette = color_createPalette(3);
+    color_setColor(palette, 0, 0, 0, 0);
+    color_setColor(palette, 255, 255, 255, 1);
+    color_setColor(palette, 0, 0, 0, 2);
+}
+
+void test_teardown()
+{
+    color_destroyPalette(palette);
+}
+
+/**
+ * @brief Renders a view with a fresh mandelData and keeps a copy of its image.
+ * @return The image, to be freed by the caller.
+ */
+unsigned int * renderFresh(int iterations, double xFrom, double yFrom, double xTo, double yTo, int width, int height)
+{
+    mandelData * m = mandel_createMandelData(iterations, xFrom, yFrom, xTo, yTo, width, height, palette);
+    unsigned int * image = (unsigned int*) malloc(sizeof(unsigned int) * width * height);
+    memcpy(image, mandel_render(m, 2, 8), sizeof(unsigned int) * width * height);
+    mandel_destroyMandelData(m);
+    return image;
+}
+
+/**
+ * @brief Renders a view at a low cap and then continues it to a higher one, and compares it with a fresh render at the higher cap.
+ * @return The number of pixels that differ, or -1 if no pixel was continued.
+ */
+int resumedDifference(double xFrom, double yFrom, double xTo, double yTo, mandelPrecision precision)
+{
+    int width = 200, height = 150;
+    mandelData * m = mandel_createMandelData(250, xFrom, yFrom, xTo, yTo, width, height, palette);
+    mandel_render(m, 2, 8);
+    mandel_setIterations(m, 1000);
+    unsigned int * resumed = mandel_render(m, 2, 8);
+
+    int differ = -1;
+    if(m->precision == precision && mandel_getStats(m).resumedPixels > 0) {
+        unsigned int * fresh = renderFresh(1000, xFrom, yFrom, xTo, yTo, width, height);
+        differ = 0;
+        for(int a = 0; a < width * height; a++) differ += resumed[a] != fresh[a];
+        free(fresh);
+    }
+
+    mandel_destroyMandelData(m);
+    return differ;
+}
+
+MU_TEST(test_tiles_cover)
+{
+    int sizes[4][2] = {{1000, 700}, {128, 128}, {130, 1}, {1, 257}};
+
+    for(int s = 0; s < 4; s++) {
+        mandelData * m = mandel_createMandelData(100, -2.0, 1.0, 1.0, -1.0, sizes[s][0], sizes[s][1], palette);
+        int count = 0;
+        pixelRect * tiles = divideImage(m, &count);
+        int * covered = (int*) calloc(m->width * m->height, sizeof(int));
+
+        for(int t = 0; t < count; t++) {
+            for(int y = tiles[t].y; y < tiles[t].y + tiles[t].h; y++) {
+                for(int x = tiles[t].x; x < tiles[t].x + tiles[t].w; x++) {
+                    if(x >= 0 && x < m->width && y >= 0 && y < m->height) covered[y * m->width + x]++;
+                }
+            }
+        }
+
+        int wrong = 0;
+        for(int a = 0; a < m->width * m->height; a++) wrong += covered[a] != 1;
+        mu_assert(wrong == 0, "every pixel should be in exactly one tile");
+
+        free(covered);
+        free(tiles);
+        mandel_destroyMandelData(m);
+    }
+}
+
+MU_TEST(test_mirror_rows)
+{
+    //the real axis lies on row 100, so rows 101 to 200 are copied from the rows above it
+    int width = 300, height = 201;
+    mandelData * m = mandel_createMandelData(500, -2.0, 1.0, 1.0, -1.0, width, height, palette);
+    mandel_render(m, 2, 8);
+    mu_assert(m->mirrorStart <= m->mirrorEnd, "the view should be mirrored");
+
+    //the mirrored rows are calculated again, one list of pixels per row
+    mandelStats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, m->precision, m->fixedBits};
+    listKernel kernel = chooseKernel(m);
+    double * ox = (double*) malloc(sizeof(double) * width);
+    double * oy = (double*) malloc(sizeof(double) * width);
+    brotStruct * out = (brotStruct*) malloc(sizeof(brotStruct) * width);
+    int differ = 0;
+
+    for(int y = m->mirrorStart; y <= m->mirrorEnd; y++) {
+        for(int x = 0; x < width; x++) {
+            ox[x] = (double)x / (double)width * m->location.w;
+            oy[x] = (double)y / (double)height * m->location.h;
+        }
+        kernel(m, ox, oy, width, m->interiorDetection, out, &stats);
+        for(int x = 0; x < width; x++) differ += m->counts[y * width + x] != out[x].n;
+    }
+
+    //a point and its mirror image are rounded apart, which can tip the iteration-count of a pixel on the boundary
+    mu_assert(differ <= width * (m->mirrorEnd - m->mirrorStart + 1) / 1000, "the mirrored rows should equal the calculated rows");
+
+    free(ox);
+    free(oy);
+    free(out);
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST(test_resume_float)
+{
+    int differ = resumedDifference(-2.0, 1.0, 1.0, -1.0, MANDEL_PRECISION_FLOAT);
+    mu_assert(differ >= 0, "the float view should be resumed");
+    mu_assert(differ == 0, "a resumed float render should equal a fresh one");
+}
+
+MU_TEST(test_resume_double)
+{
+    double x = -0.743643887037, y = 0.131825904205, r = 1e-8;
+    int differ = resumedDifference(x - r, y + r * 0.75, x + r, y - r * 0.75, MANDEL_PRECISION_DOUBLE);
+    mu_assert(differ >= 0, "the double view should be resumed");
+    mu_assert(differ == 0, "a resumed double render should equal a fresh one");
+}
+
+MU_TEST(test_resume_rectangle_checking)
+{
+    double x = -0.74364, y = 0.13183, r = 2e-4;
+    int width = 400, height = 300;
+    mandelData * m = mandel_createMandelData(250, x - r, y + r * 0.75, x + r, y - r * 0.75, width, height, palette);
+    mandel_setRectangleChecking(m, true);
+    mandel_render(m, 2, 8);
+    mandel_setIterations(m, 5000);
+    unsigned int * raised = mandel_render(m, 2, 8);
+
+    mandelData * f = mandel_createMandelData(5000, x - r, y + r * 0.75, x + r, y - r * 0.75, width, height, palette);
+    mandel_setRectangleChecking(f, true);
+    unsigned int * fresh = mandel_render(f, 2, 8);
+
+    int differ = 0;
+    for(int a = 0; a < width * height; a++) differ += raised[a] != fresh[a];
+    mu_assert(differ == 0, "raising the cap of a rectangle checked render should equal a fresh one");
+
+    mandel_destroyMandelData(f);
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST(test_realtime_changed)
+{
+    mandelData * m = mandel_createMandelData(200, -2.0, 1.0, 1.0, -1.0, 64, 48, palette);
+    mandelRealtime * r = mandel_createRealtime(m, 2);
+
+    for(int frame = 0; frame < 100 && !mandel_isFrameComplete(r); frame++) mandel_renderFrame(r, 1.0);
+    mu_assert(mandel_isFrameComplete(r), "the frames should reach full resolution");
+
+    color_setColor(palette, 255, 0, 0, 1);
+    mu_assert(!mandel_isFrameComplete(r), "a new color should start the passes over");
+    for(int frame = 0; frame < 100 && !mandel_isFrameComplete(r); frame++) mandel_renderFrame(r, 1.0);
+
+    mandel_setRenderMode(m, MANDEL_RENDER_DISTANCE);
+    mu_assert(!mandel_isFrameComplete(r), "a new render mode should start the passes over");
+    for(int frame = 0; frame < 100 && !mandel_isFrameComplete(r); frame++) mandel_renderFrame(r, 1.0);
+
+    mandel_setInteriorDetection(m, true);
+    mu_assert(!mandel_isFrameComplete(r), "turning on interior detection should start the passes over");
+
+    mandel_destroyRealtime(r);
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST(test_thread_pinning)
+{
+    int width = 200, height = 150;
+    unsigned int * fresh = renderFresh(500, -2.0, 1.0, 1.0, -1.0, width, height);
+
+    mandelData * m = mandel_createMandelData(500, -2.0, 1.0, 1.0, -1.0, width, height, palette);
+    mandel_render(m, 2, 8);
+    mandel_setThreadPinning(m, true);
+    mu_assert(m->pool == NULL, "the threads should be created again to be pinned");
+    unsigned int * pinned = mandel_render(m, 2, 8);
+
+    int differ = 0;
+    for(int a = 0; a < width * height; a++) differ += pinned[a] != fresh[a];
+    mu_assert(differ == 0, "a render with pinned threads should equal one without");
+
+    free(fresh);
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST(test_budget_deadline)
+{
+    //deep enough for double-double, where the first pass alone at the full cap takes far longer than the budget
+    double x = -0.743643887037, y = 0.131825904205, r = 2.5e-14, budget = 0.05;
+    mandelData * m = mandel_createMandelData(50000, x - r, y + r, x + r, y - r, 256, 256, palette);
+    mandel_setPerturbation(m, false);
+
+    double start = monotonicSeconds();
+    mandel_renderBudget(m, 2, 8, budget);
+    double elapsed = monotonicSeconds() - start;
+
+    int count = 0;
+    const mandelRegionQuality * quality = mandel_getQuality(m, &count);
+    mu_assert(elapsed < 2.0 * budget, "the render should stop close to its deadline");
+    mu_assert(count > 0 && quality[0].iterations < 50000, "the iteration cap should be lowered");
+    mu_assert(mandel_getIterations(m) == 50000, "the lowered cap should only be used for the render");
+
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST(test_budget_complete)
+{
+    int width = 200, height = 150;
+    mandelData * m = mandel_createMandelData(500, -2.0, 1.0, 1.0, -1.0, width, height, palette);
+    unsigned int * image = mandel_renderBudget(m, 2, 8, 60.0);
+
+    int count = 0;
+    const mandelRegionQuality * quality = mandel_getQuality(m, &count);
+    for(int a = 0; a < count; a++) {
+        mu_assert(quality[a].step == 1 && quality[a].iterations == 500, "every part should reach full resolution at the full cap");
+    }
+
+    unsigned int * fresh = renderFresh(500, -2.0, 1.0, 1.0, -1.0, width, height);
+    int differ = 0;
+    for(int a = 0; a < width * height; a++) differ += image[a] != fresh[a];
+    mu_assert(differ == 0, "a render with a large budget should equal a render without one");
+
+    free(fresh);
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST(test_tiled_layout)
+{
+    //the size is not a multiple of the blocks, so the blocks at the edges are cut
+    int width = 200, height = 151;
+    unsigned int * fresh = renderFresh(500, -2.0, 1.0, 1.0, -1.0, width, height);
+    unsigned int * exported = (unsigned int*) malloc(sizeof(unsigned int) * width * height);
+
+    mandelData * m = mandel_createMandelData(250, -2.0, 1.0, 1.0, -1.0, width, height, palette);
+    mandel_setTiledLayout(m, true);
+    mandel_render(m, 2, 8);
+    mandel_setIterations(m, 500);
+    mandel_render(m, 2, 8);
+    mandel_exportImage(m, exported);
+
+    int differ = 0;
+    for(int a = 0; a < width * height; a++) differ += exported[a] != fresh[a];
+    mu_assert(differ == 0, "a resumed render in blocks should equal a render in rows");
+
+    mandel_renderBudget(m, 2, 8, 60.0);
+    mandel_exportImage(m, exported);
+
+    differ = 0;
+    for(int a = 0; a < width * height; a++) differ += exported[a] != fresh[a];
+    mu_assert(differ == 0, "a render with a budget in blocks should equal a render in rows");
+
+    mandel_setTiledLayout(m, false);
+    mandel_render(m, 2, 8);
+    mandel_exportImage(m, exported);
+
+    differ = 0;
+    for(int a = 0; a < width * height; a++) differ += exported[a] != fresh[a];
+    mu_assert(differ == 0, "the image should be exported as it is in rows");
+
+    free(fresh);
+    free(exported);
+    mandel_destroyMandelData(m);
+}
+
+MU_TEST_SUITE(test_suite)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_tiles_cover);
+    MU_RUN_TEST(test_mirror_rows);
+    MU_RUN_TEST(test_resume_float);
+    MU_RUN_TEST(test_resume_double);
+    MU_RUN_TEST(test_resume_rectangle_checking);
+    MU_RUN_TEST(test_realtime_changed);
+    MU_RUN_TEST(test_thread_pinning);
+    MU_RUN_TEST(test_budget_deadline);
+    MU_RUN_TEST(test_budget_complete);
+    MU_RUN_TEST(test_tiled_layout);
+}
+
+int main(int argc, char *argv[])
+{
+    MU_RUN_SUITE(test_suite);
+    MU_REPORT();
+    return 0;
+}
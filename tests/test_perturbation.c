@@ -0,0 +1,123 @@
+/**
+ * @file test_perturbation.c
+ * @date 18/10 2026
+ * @brief Tests for the perturbation of a reference orbit
+ */
+
+#include "minunit.h"
+#include "../src/perturbation.h"
+
+void test_setup()
+{
+
+}
+
+void test_teardown()
+{
+    // Nothing
+}
+
+/**
+ * @brief Iterates a point directly in double precision.
+ * @param x0 x-position in the complex-plane.
+ * @param y0 y-position in the complex-plane.
+ * @param nMax The maximum number of iterations.
+ * @return The final iteration-count.
+ */
+int directCount(double x0, double y0, int nMax)
+{
+    double x = 0.0, y = 0.0, xTemp = 0.0;
+    int i = 0;
+
+    while(x*x + y*y < 100.0 && i < nMax) {
+        xTemp = x*x - y*y + x0;
+        y = 2.0*x*y + y0;
+        x = xTemp;
+        i++;
+    }
+
+    return i;
+}
+
+MU_TEST(test_perturb_orbit)
+{
+    refOrbit * r = perturb_createOrbit(dd_fromDouble(-1.0), dd_fromDouble(0.0), 100);
+    mu_assert(r->length == 100, "-1 should never escape");
+    mu_assert(r->x[1] == -1.0 && r->x[2] == 0.0 && r->x[3] == -1.0, "-1 should alternate between -1 and 0");
+    perturb_destroyOrbit(r);
+
+    r = perturb_createOrbit(dd_fromDouble(1.0), dd_fromDouble(1.0), 100);
+    mu_assert(r->length < 10, "1 + i should escape fast");
+    perturb_destroyOrbit(r);
+}
+
+//points close to a reference that stays bounded should get the same counts as when iterated directly
+MU_TEST(test_perturb_matchesDirect)
+{
+    double refX = -0.7436, refY = 0.1318;
+    double dcx[4] = {0.001, -0.002, 0.0005, 0.003};
+    double dcy[4] = {0.0, 0.001, -0.0025, 0.002};
+    perturbResult out[4];
+
+    refOrbit * r = perturb_createOrbit(dd_fromDouble(refX), dd_fromDouble(refY), 1000);
+    perturb_inBrotList(r, dcx, dcy, 4, 1000, 0, false, out);
+
+    for(int a = 0; a < 4; a++) {
+        mu_assert(!out[a].glitched, "the reference should outlive the points");
+        mu_assert(out[a].n == directCount(refX + dcx[a], refY + dcy[a], 1000), "the count should match direct iteration");
+    }
+
+    perturb_destroyOrbit(r);
+}
+
+//a reference that stops before the point escapes can not be used for the rest of its orbit
+MU_TEST(test_perturb_glitch)
+{
+    double dcx[1] = {-3.0};
+    double dcy[1] = {0.0};
+    perturbResult out[1];
+
+    refOrbit * r = perturb_createOrbit(dd_fromDouble(8.0), dd_fromDouble(0.0), 1);
+    perturb_inBrotList(r, dcx, dcy, 1, 100, 0, false, out);
+    mu_assert(out[0].n == 1 && out[0].glitched, "5 + 0i outlives a reference of length 1 and should be glitched");
+    perturb_destroyOrbit(r);
+}
+
+//points very close to the reference follow it for a long time, and skipping should not change their counts
+MU_TEST(test_perturb_seriesSkip)
+{
+    double dcx[3] = {1e-12, -2e-12, 0.5e-12};
+    double dcy[3] = {0.0, 1e-12, -2e-12};
+    perturbResult exact[3], skipped[3];
+
+    refOrbit * r = perturb_createOrbit(dd_fromDouble(-0.7436), dd_fromDouble(0.1318), 1000);
+    int skip = perturb_seriesSkip(r, dcx, dcy, 3, 1000, 1e-15);
+    mu_assert(skip > 0 && skip < r->length, "the series should skip a part of the orbit");
+
+    perturb_inBrotList(r, dcx, dcy, 3, 1000, 0, false, exact);
+    perturb_inBrotList(r, dcx, dcy, 3, 1000, skip, false, skipped);
+    for(int a = 0; a < 3; a++) {
+        mu_assert(skipped[a].skipped == skip, "every point should start after the skipped iterations");
+        mu_assert(skipped[a].n == exact[a].n, "the count should not change when skipping");
+    }
+
+    mu_assert(perturb_seriesSkip(r, dcx, dcy, 0, 1000, 1e-15) == 0, "an empty list skips nothing");
+    perturb_destroyOrbit(r);
+}
+
+MU_TEST_SUITE(test_suite)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_perturb_orbit);
+    MU_RUN_TEST(test_perturb_matchesDirect);
+    MU_RUN_TEST(test_perturb_glitch);
+    MU_RUN_TEST(test_perturb_seriesSkip);
+}
+
+int main(int argc, char *argv[])
+{
+    MU_RUN_SUITE(test_suite);
+    MU_REPORT();
+    return 0;
+}
@@ -23,6 +23,52 @@ void job(void * arg)
     printf("Job: %i done\n", *iarg);
 }
 
+//the jobs of test_threadpool_nested split into two jobs until they reach the depth, and count the leaves
+#define NESTED_DEPTH 8
+
+struct threadpool * nestedPool;
+pthread_mutex_t nestedLock = PTHREAD_MUTEX_INITIALIZER;
+int nestedLeaves;
+
+void nestedJob(void * arg)
+{
+    int depth = (int)(size_t)arg;
+
+    if(depth == NESTED_DEPTH) {
+        pthread_mutex_lock(&nestedLock);
+        nestedLeaves++;
+        pthread_mutex_unlock(&nestedLock);
+        return;
+    }
+
+    threadpool_enqueue(nestedPool, nestedJob, (void*)(size_t)(depth + 1));
+    threadpool_enqueue(nestedPool, nestedJob, (void*)(size_t)(depth + 1));
+}
+
+//the jobs of test_threadpool_steal, the first waits for the second although both are given to the same thread
+struct threadpool * stealPool;
+pthread_mutex_t stealLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t stealDone = PTHREAD_COND_INITIALIZER;
+bool stealFlag;
+int stealThreads[2];
+
+void waitingJob(void * arg)
+{
+    stealThreads[0] = threadpool_currentThread(stealPool);
+    pthread_mutex_lock(&stealLock);
+    while(!stealFlag) pthread_cond_wait(&stealDone, &stealLock);
+    pthread_mutex_unlock(&stealLock);
+}
+
+void signalingJob(void * arg)
+{
+    stealThreads[1] = threadpool_currentThread(stealPool);
+    pthread_mutex_lock(&stealLock);
+    stealFlag = true;
+    pthread_cond_broadcast(&stealDone);
+    pthread_mutex_unlock(&stealLock);
+}
+
 void test_setup()
 {
 
@@ -38,11 +84,49 @@ MU_TEST(test_dummy)
     mu_assert(true == true, "dummy");
 }
 
+//threadpool_wait should also wait for the jobs added by jobs, and the pool should be usable again afterwards
+MU_TEST(test_threadpool_nested)
+{
+    nestedPool = threadpool_create(4);
+
+    threadpool_wait(nestedPool);
+
+    nestedLeaves = 0;
+    threadpool_enqueue(nestedPool, nestedJob, (void*)(size_t)0);
+    threadpool_wait(nestedPool);
+    mu_assert(nestedLeaves == 1 << NESTED_DEPTH, "every nested job should be done after threadpool_wait");
+
+    nestedLeaves = 0;
+    threadpool_enqueue(nestedPool, nestedJob, (void*)(size_t)(NESTED_DEPTH - 1));
+    threadpool_destroy(nestedPool);
+    mu_assert(nestedLeaves == 2, "threadpool_destroy should wait for the nested jobs");
+}
+
+//a job given to a busy thread should be taken by another thread
+MU_TEST(test_threadpool_steal)
+{
+    stealPool = threadpool_create(2);
+    stealFlag = false;
+
+    mu_assert(threadpool_currentThread(stealPool) == -1, "the calling thread is not in the pool");
+
+    threadpool_enqueueTo(stealPool, waitingJob, NULL, 0);
+    threadpool_enqueueTo(stealPool, signalingJob, NULL, 0);
+    threadpool_wait(stealPool);
+
+    mu_assert(stealThreads[0] != stealThreads[1], "the second job should have been stolen");
+    mu_assert(stealThreads[0] >= 0 && stealThreads[0] < 2 && stealThreads[1] >= 0 && stealThreads[1] < 2, "the jobs should know their threads");
+
+    threadpool_destroy(stealPool);
+}
+
 MU_TEST_SUITE(test_suite)
 {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
     MU_RUN_TEST(test_dummy);
+    MU_RUN_TEST(test_threadpool_nested);
+    MU_RUN_TEST(test_threadpool_steal);
 
 }
 